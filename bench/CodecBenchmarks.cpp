@@ -0,0 +1,178 @@
+/**
+ * \file    CodecBenchmarks.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/CobsTranscoder.h"
+#include "EmbeddedSerialFiller/Utilities.h"
+#include "Sweeps.h"
+
+using namespace esf;
+using namespace esf_bench;
+
+namespace
+{
+void BM_CobsEncode( benchmark::State& state )
+{
+    ByteArray raw, encoded;
+    MakePayload( raw, state.range( 0 ), state.range( 1 ) );
+    for( auto _ : state )
+    {
+        CobsTranscoder::Encode( raw, encoded );
+        benchmark::DoNotOptimize( encoded.data() );
+    }
+    state.SetBytesProcessed( state.iterations() * raw.size() );
+}
+BENCHMARK( BM_CobsEncode )->Apply( SizesAndZeros );
+
+void BM_CobsEncodeRaw( benchmark::State& state )
+{
+    ByteArray raw;
+    MakePayload( raw, state.range( 0 ), state.range( 1 ) );
+    // COBS adds a byte per 254 and the terminating 0x00.
+    uint8_t encoded[ ESF_MAX_PACKET_SIZE + ESF_MAX_PACKET_SIZE / 254 + 2 ];
+    for( auto _ : state )
+    {
+        CobsTranscoder::Encode( raw.data(), raw.size(), encoded );
+        benchmark::DoNotOptimize( encoded );
+    }
+    state.SetBytesProcessed( state.iterations() * raw.size() );
+}
+BENCHMARK( BM_CobsEncodeRaw )->Apply( SizesAndZeros );
+
+void BM_CobsDecode( benchmark::State& state )
+{
+    ByteArray raw, encoded, decoded;
+    MakePayload( raw, state.range( 0 ), state.range( 1 ) );
+    CobsTranscoder::Encode( raw, encoded );
+    for( auto _ : state )
+    {
+        benchmark::DoNotOptimize( CobsTranscoder::Decode( encoded, decoded ) );
+    }
+    state.SetBytesProcessed( state.iterations() * raw.size() );
+}
+BENCHMARK( BM_CobsDecode )->Apply( SizesAndZeros );
+
+void BM_CobsDecodeRaw( benchmark::State& state )
+{
+    ByteArray raw, encoded;
+    MakePayload( raw, state.range( 0 ), state.range( 1 ) );
+    CobsTranscoder::Encode( raw, encoded );
+    uint8_t decoded[ ESF_MAX_PACKET_SIZE ];
+    for( auto _ : state )
+    {
+        benchmark::DoNotOptimize( CobsTranscoder::Decode( encoded.data(), encoded.size(), decoded ) );
+    }
+    state.SetBytesProcessed( state.iterations() * raw.size() );
+}
+BENCHMARK( BM_CobsDecodeRaw )->Apply( SizesAndZeros );
+
+void BM_AddCrc( benchmark::State& state )
+{
+    ByteArray packet;
+    MakePayload( packet, state.range( 0 ), 10 );
+    for( auto _ : state )
+    {
+        Utilities::AddCrc( packet );
+        packet.resize( packet.size() - 2 );
+    }
+    state.SetBytesProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( BM_AddCrc )->Apply( Sizes );
+
+void BM_VerifyCrc( benchmark::State& state )
+{
+    ByteArray packet;
+    MakePayload( packet, state.range( 0 ), 10 );
+    Utilities::AddCrc( packet );
+    for( auto _ : state )
+    {
+        benchmark::DoNotOptimize( Utilities::VerifyCrc( packet ) );
+    }
+    state.SetBytesProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( BM_VerifyCrc )->Apply( Sizes );
+
+/// \brief      A burst of 8 frames of state.range( 0 ) bytes, mostly smaller than Sizes() goes, as checked one by one
+///             and as a batch.
+void SmallSizes( benchmark::internal::Benchmark* b )
+{
+    b->ArgName( "size" )->Arg( 8 )->Arg( 16 )->Arg( 32 )->Arg( 256 );
+}
+
+void MakeBurst( ByteArray ( &packets )[ 8 ], const IByteArray* ( &pointers )[ 8 ], size_t size )
+{
+    for( int i = 0; i < 8; ++i )
+    {
+        MakePayload( packets[ i ], size + i % 2, 10 );
+        Utilities::AddCrc( packets[ i ] );
+        pointers[ i ] = &packets[ i ];
+    }
+}
+
+void BM_VerifyCrcBurst( benchmark::State& state )
+{
+    ByteArray packets[ 8 ];
+    const IByteArray* pointers[ 8 ];
+    MakeBurst( packets, pointers, state.range( 0 ) );
+    for( auto _ : state )
+    {
+        for( int i = 0; i < 8; ++i )
+        {
+            benchmark::DoNotOptimize( Utilities::VerifyCrc( packets[ i ] ) );
+        }
+    }
+    state.SetBytesProcessed( state.iterations() * 8 * state.range( 0 ) );
+}
+BENCHMARK( BM_VerifyCrcBurst )->Apply( SmallSizes );
+
+void BM_VerifyCrcs( benchmark::State& state )
+{
+    ByteArray packets[ 8 ];
+    const IByteArray* pointers[ 8 ];
+    MakeBurst( packets, pointers, state.range( 0 ) );
+    for( auto _ : state )
+    {
+        benchmark::DoNotOptimize( Utilities::VerifyCrcs( pointers, 8 ) );
+    }
+    state.SetBytesProcessed( state.iterations() * 8 * state.range( 0 ) );
+}
+BENCHMARK( BM_VerifyCrcs )->Apply( SmallSizes );
+
+void BM_SplitPacket( benchmark::State& state )
+{
+    // [ <type>, <packet ID>, <topic length>, <topic>, <data>, <CRC> ], as SplitPacket() expects from startAt.
+    ByteArray packet( { 0x42, 0x01, 5, 't', 'o', 'p', 'i', 'c' } );
+    ByteArray payload, data;
+    MakePayload( payload, state.range( 0 ), 10 );
+    packet.insert( packet.end(), payload.begin(), payload.end() );
+    Utilities::AddCrc( packet );
+    Topic topic;
+    for( auto _ : state )
+    {
+        benchmark::DoNotOptimize( Utilities::SplitPacket( packet, 2, topic, data ) );
+    }
+    state.SetBytesProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( BM_SplitPacket )->Apply( Sizes );
+
+void BM_MoveRxDataInBuffer( benchmark::State& state )
+{
+    ByteArray raw, encoded, rxData, packet;
+    MakePayload( raw, state.range( 0 ), state.range( 1 ) );
+    CobsTranscoder::Encode( raw, encoded );
+    ByteArray rxBuffer;
+    for( auto _ : state )
+    {
+        // MoveRxDataInBuffer() consumes its input.
+        state.PauseTiming();
+        rxData = encoded;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize( Utilities::MoveRxDataInBuffer( rxData, rxBuffer, packet ) );
+    }
+    state.SetBytesProcessed( state.iterations() * encoded.size() );
+}
+BENCHMARK( BM_MoveRxDataInBuffer )->Apply( SizesAndZeros );
+
+}  // namespace
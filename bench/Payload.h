@@ -0,0 +1,36 @@
+/**
+ * \file    Payload.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_BENCH_PAYLOAD_H
+#define ESF_BENCH_PAYLOAD_H
+
+#include <cstdint>
+
+#include "EmbeddedSerialFiller/Definitions.h"
+
+namespace esf_bench
+{
+/// \brief      Payload sizes swept by the benchmarks, the largest still fitting a packet once framed.
+const int SIZES[] = { 16, 64, 256, 960 };
+/// \brief      Percentages of zero bytes swept, which is what COBS encoding costs depend on.
+const int ZEROS[] = { 0, 10, 50, 100 };
+
+/// \brief      Fills \p payload with \p size bytes, about \p zeroPercent of them 0x00. The same every time.
+inline void MakePayload( esf::IByteArray& payload, size_t size, int zeroPercent )
+{
+    uint32_t seed = 0x12345678;
+    payload.clear();
+    for( size_t i = 0; i < size; ++i )
+    {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t random = seed >> 8;
+        payload.push_back( static_cast<int>( random % 100 ) < zeroPercent ? 0x00 : static_cast<uint8_t>( 1 + ( random >> 8 ) % 255 ) );
+    }
+}
+
+}  // namespace esf_bench
+
+#endif  // #ifndef ESF_BENCH_PAYLOAD_H
@@ -0,0 +1,137 @@
+/**
+ * \file    RoundTripBenchmarks.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "Sweeps.h"
+
+using namespace esf;
+using namespace esf_bench;
+
+namespace
+{
+// Loopback between two nodes re-enters the library from within txDataReady_, which the static mutex of the
+// DefaultConfig doesn't allow, so the round trips run without a lock.
+struct LoopbackConfig : DefaultConfig
+{
+    typedef NoLock Lock;
+};
+typedef BasicEmbeddedSerialFiller<LoopbackConfig> LoopbackNode;
+
+/// \brief      Two nodes, each sending straight into the other's GiveRxData().
+class Link
+{
+   public:
+    Link() : received_( 0 )
+    {
+        a_.txDataReady_ = etl::delegate<void( const ByteArray& )>::create<Link, &Link::AToB>( *this );
+        b_.txDataReady_ = etl::delegate<void( const ByteArray& )>::create<Link, &Link::BToA>( *this );
+        b_.Subscribe( "bench", etl::delegate<void( ByteArray& )>::create<Link, &Link::OnData>( *this ) );
+    }
+
+    void AToB( const ByteArray& data ) { b_.GiveRxData( const_cast<ByteArray&>( data ) ); }
+    void BToA( const ByteArray& data ) { a_.GiveRxData( const_cast<ByteArray&>( data ) ); }
+    void OnData( ByteArray& ) { ++received_; }
+
+    LoopbackNode a_;
+    LoopbackNode b_;
+    int64_t received_;
+};
+
+/// \brief      Drops (or keeps the last of) everything sent.
+class Sink
+{
+   public:
+    void Write( const ByteArray& data ) { benchmark::DoNotOptimize( data.data() ); }
+    void Capture( const ByteArray& data ) { frame_ = data; }
+
+    ByteArray frame_;
+};
+
+// Publish() through COBS and the CRC into the other node's GiveRxData(), which dispatches it and acknowledges it.
+void BM_PublishRoundTrip( benchmark::State& state )
+{
+    Link link;
+    ByteArray payload;
+    MakePayload( payload, state.range( 0 ), state.range( 1 ) );
+    for( auto _ : state )
+    {
+        link.a_.Publish( "bench", payload );
+    }
+    if( link.received_ != state.iterations() )
+    {
+        state.SkipWithError( "Not every packet was received" );
+    }
+    state.SetBytesProcessed( state.iterations() * payload.size() );
+    state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_PublishRoundTrip )->Apply( SizesAndZeros );
+
+// As above, with the ACK found by PublishWait() once it has been received.
+void BM_PublishWaitRoundTrip( benchmark::State& state )
+{
+    Link link;
+    ByteArray payload;
+    MakePayload( payload, state.range( 0 ), 10 );
+    for( auto _ : state )
+    {
+        if( link.a_.PublishWait( "bench", payload, 100 ) != PublishResponse::SUCCESS )
+        {
+            state.SkipWithError( "PublishWait() wasn't acknowledged" );
+            break;
+        }
+    }
+    state.SetBytesProcessed( state.iterations() * payload.size() );
+    state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_PublishWaitRoundTrip )->Apply( Sizes );
+
+// The transmit half only, with the DefaultConfig's lock.
+void BM_Publish( benchmark::State& state )
+{
+    EmbeddedSerialFiller node;
+    Sink sink;
+    node.txDataReady_ = etl::delegate<void( const ByteArray& )>::create<Sink, &Sink::Write>( sink );
+    ByteArray payload;
+    MakePayload( payload, state.range( 0 ), state.range( 1 ) );
+    for( auto _ : state )
+    {
+        node.Publish( "bench", payload );
+    }
+    state.SetBytesProcessed( state.iterations() * payload.size() );
+    state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_Publish )->Apply( SizesAndZeros );
+
+// The receive half only, of a packet captured from Publish(). Its ACK goes to a Sink.
+void BM_GiveRxData( benchmark::State& state )
+{
+    Link link;
+    ByteArray payload;
+    MakePayload( payload, state.range( 0 ), state.range( 1 ) );
+    Sink sink;
+    link.a_.txDataReady_ = etl::delegate<void( const ByteArray& )>::create<Sink, &Sink::Capture>( sink );
+    link.b_.txDataReady_ = etl::delegate<void( const ByteArray& )>::create<Sink, &Sink::Write>( sink );
+    link.a_.Publish( "bench", payload );
+
+    ByteArray rxData;
+    for( auto _ : state )
+    {
+        // GiveRxData() consumes its input.
+        state.PauseTiming();
+        rxData = sink.frame_;
+        state.ResumeTiming();
+        link.b_.GiveRxData( rxData );
+    }
+    if( link.received_ != state.iterations() )
+    {
+        state.SkipWithError( "Not every packet was received" );
+    }
+    state.SetBytesProcessed( state.iterations() * payload.size() );
+    state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_GiveRxData )->Apply( SizesAndZeros );
+
+}  // namespace
@@ -0,0 +1,41 @@
+/**
+ * \file    Sweeps.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_BENCH_SWEEPS_H
+#define ESF_BENCH_SWEEPS_H
+
+#include <benchmark/benchmark.h>
+
+#include "Payload.h"
+
+namespace esf_bench
+{
+/// \brief      Runs a benchmark for each payload size (state.range( 0 )).
+inline void Sizes( benchmark::internal::Benchmark* b )
+{
+    b->ArgName( "size" );
+    for( int size : SIZES )
+    {
+        b->Arg( size );
+    }
+}
+
+/// \brief      Runs a benchmark for each payload size (state.range( 0 )) and zero density (state.range( 1 )).
+inline void SizesAndZeros( benchmark::internal::Benchmark* b )
+{
+    b->ArgNames( { "size", "zeros" } );
+    for( int size : SIZES )
+    {
+        for( int zeros : ZEROS )
+        {
+            b->Args( { size, zeros } );
+        }
+    }
+}
+
+}  // namespace esf_bench
+
+#endif  // #ifndef ESF_BENCH_SWEEPS_H
@@ -0,0 +1,404 @@
+/**
+ * \file    ContentionHarness.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+// Publisher threads contending for the lock of one node, or of many nodes sharing a Config (and so, the lock being
+// static, the same one). Each node is linked to a peer through unbounded in-process pipes, each side read by its own
+// thread, so the only blocking is on the locks. For every combination of thread count, share of PublishWait() (the
+// rest are Publish()), payload size and instance count, reports messages/s, how long the lock was waited for and held
+// (from a Config::Lock that times a std::mutex) and the latency of each publish.
+//
+// EmbeddedSerialFillerContentionHarness [--threads 1,2,4,8,12] [--wait 0,50,100] [--sizes 16,256]
+//                                       [--instances 1,0] [--messages <per thread>] [--timeout <ms>] [--json <file>]
+//
+// --wait is the percentage of PublishWait() calls, in steps of 10. An --instances of 0 gives every thread its own.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "../Payload.h"
+#include "Harness.h"
+
+using namespace esf;
+using namespace esf_bench;
+
+namespace
+{
+/// \brief      The lock times of one thread.
+struct LockTimes
+{
+    Latencies wait;
+    Latencies hold;
+};
+
+/// \brief      Where TimedLock records the calling thread's lock times, none if nullptr.
+thread_local LockTimes* lockTimes = nullptr;
+
+/// \brief      MutexLock on a std::mutex, timing each wait for it and each hold of it.
+/// \details    Time spent in Wait() is for the ACK, so neither; the mutex is taken back within it untimed.
+class TimedLock
+{
+   public:
+    typedef RelaxedCounter Counter;
+    typedef std::condition_variable Signal;
+
+    void Create() {}
+
+    class Guard
+    {
+       public:
+        Guard( TimedLock& policy, bool ) : lock_( policy.mutex_, std::defer_lock ), acquired_( 0 ) { lock(); }
+        ~Guard()
+        {
+            if( lock_.owns_lock() )
+            {
+                unlock();
+            }
+        }
+        void lock()
+        {
+            uint64_t start = NowNs();
+            lock_.lock();
+            acquired_ = NowNs();
+            if( lockTimes != nullptr )
+            {
+                lockTimes->wait.Add( acquired_ - start );
+            }
+        }
+        void unlock()
+        {
+            EndHold();
+            lock_.unlock();
+        }
+        bool Wait( Signal& signal, const bool&, uint32_t timeout )
+        {
+            EndHold();
+            bool woken = signal.wait_for( lock_, std::chrono::milliseconds( timeout ) ) == std::cv_status::no_timeout;
+            acquired_ = NowNs();
+            return woken;
+        }
+
+       private:
+        void EndHold()
+        {
+            if( lockTimes != nullptr )
+            {
+                lockTimes->hold.Add( NowNs() - acquired_ );
+            }
+        }
+
+        std::unique_lock<std::mutex> lock_;
+        uint64_t acquired_;
+    };
+
+   private:
+    std::mutex mutex_;
+};
+
+// Frames are held through callbacks, when the lock is not, so each reader thread can hold two at once.
+const size_t NODE_FRAMES = 32;
+
+/// \brief      The nodes under test, all sharing its TimedLock.
+struct TimedConfig : DefaultConfig
+{
+    typedef TimedLock Lock;
+    static const size_t PENDING_ACKS = 16;
+    static const size_t FRAMES = NODE_FRAMES;
+};
+typedef BasicEmbeddedSerialFiller<TimedConfig> TimedNode;
+
+/// \brief      Their peers, with a lock of their own so as not to add to the contention measured.
+struct PeerConfig : DefaultConfig
+{
+    static const size_t FRAMES = NODE_FRAMES;
+};
+typedef BasicEmbeddedSerialFiller<PeerConfig> PeerNode;
+
+const char* const TOPIC = "bench";
+
+/// \brief      One direction of an in-process link, unbounded so that no write waits on the reader.
+class Pipe
+{
+   public:
+    Pipe() : closed_( false ) {}
+
+    void Write( const IByteArray& data )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        bytes_.insert( bytes_.end(), data.begin(), data.end() );
+        ready_.notify_one();
+    }
+
+    /// \returns    False once the pipe is closed and empty, otherwise as many bytes as are waiting and fit \p data.
+    bool Read( IByteArray& data )
+    {
+        std::unique_lock<std::mutex> lock( mutex_ );
+        ready_.wait( lock, [this]() { return closed_ || !bytes_.empty(); } );
+        if( bytes_.empty() )
+        {
+            return false;
+        }
+        size_t count = std::min( bytes_.size(), data.max_size() );
+        data.assign( bytes_.begin(), bytes_.begin() + count );
+        bytes_.erase( bytes_.begin(), bytes_.begin() + count );
+        return true;
+    }
+
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        closed_ = true;
+        ready_.notify_one();
+    }
+
+   private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<uint8_t> bytes_;
+    bool closed_;
+};
+
+/// \brief      A node under test, its peer and the threads reading for each.
+class Instance
+{
+   public:
+    Instance()
+    {
+        node_.txDataReady_ = etl::delegate<void( const TimedNode::ByteArray& )>::create<Instance, &Instance::ToPeer>( *this );
+        peer_.txDataReady_ = etl::delegate<void( const PeerNode::ByteArray& )>::create<Instance, &Instance::ToNode>( *this );
+        peer_.Subscribe( TOPIC, etl::delegate<void( PeerNode::ByteArray& )>::create<Instance, &Instance::OnData>( *this ) );
+    }
+
+    /// \param  times   Where the node's reader records its lock times.
+    void Start( LockTimes* times )
+    {
+        nodeReader_ = std::thread( [this, times]() {
+            lockTimes = times;
+            TimedNode::ByteArray rxData;
+            while( toNode_.Read( rxData ) )
+            {
+                node_.GiveRxData( rxData );
+            }
+        } );
+        peerReader_ = std::thread( [this]() {
+            PeerNode::ByteArray rxData;
+            while( toPeer_.Read( rxData ) )
+            {
+                peer_.GiveRxData( rxData );
+            }
+        } );
+    }
+
+    void Stop()
+    {
+        toPeer_.Close();
+        peerReader_.join();
+        toNode_.Close();
+        nodeReader_.join();
+    }
+
+    TimedNode node_;
+
+   private:
+    void ToPeer( const TimedNode::ByteArray& data ) { toPeer_.Write( data ); }
+    void ToNode( const PeerNode::ByteArray& data ) { toNode_.Write( data ); }
+    void OnData( PeerNode::ByteArray& ) {}
+
+    PeerNode peer_;
+    Pipe toPeer_;
+    Pipe toNode_;
+    std::thread nodeReader_;
+    std::thread peerReader_;
+};
+
+struct Options
+{
+    std::vector<int> threads;
+    std::vector<int> wait;
+    std::vector<int> sizes;
+    std::vector<int> instances;
+    int messages;
+    uint32_t timeout;
+    std::string json;
+};
+
+/// \brief      One run, adding its row to \p report.
+void Run( int threads, int waitPercent, int size, int instanceCount, const Options& options, Report& report )
+{
+    std::vector<std::unique_ptr<Instance> > instances;
+    for( int i = 0; i < instanceCount; ++i )
+    {
+        instances.push_back( std::unique_ptr<Instance>( new Instance() ) );
+    }
+    // Publishers' lock times first, then the readers'.
+    std::vector<LockTimes> times( threads + instanceCount );
+    for( int i = 0; i < instanceCount; ++i )
+    {
+        instances[ i ]->Start( &times[ threads + i ] );
+    }
+
+    TimedNode::ByteArray payload;
+    MakePayload( payload, size, 10 );
+
+    std::atomic<bool> go( false );
+    std::atomic<uint64_t> timeouts( 0 );
+    uint32_t misses = TimedNode::Frames().Misses() + PeerNode::Frames().Misses();
+    std::vector<Latencies> latencies( threads );
+    std::vector<std::thread> publishers;
+    for( int i = 0; i < threads; ++i )
+    {
+        publishers.push_back( std::thread( [&, i]() {
+            TimedNode& node = instances[ i % instanceCount ]->node_;
+            lockTimes = &times[ i ];
+            latencies[ i ].Reserve( options.messages );
+            while( !go )
+            {
+                std::this_thread::yield();
+            }
+            for( int message = 0; message < options.messages; ++message )
+            {
+                uint64_t start = NowNs();
+                if( ( message % 10 ) < waitPercent / 10 )
+                {
+                    if( node.PublishWait( TOPIC, payload, options.timeout ) != PublishResponse::SUCCESS )
+                    {
+                        ++timeouts;
+                        continue;
+                    }
+                }
+                else
+                {
+                    node.Publish( TOPIC, payload );
+                }
+                latencies[ i ].Add( NowNs() - start );
+            }
+            lockTimes = nullptr;
+        } ) );
+    }
+
+    uint64_t start = NowNs();
+    go = true;
+    for( auto& publisher : publishers )
+    {
+        publisher.join();
+    }
+    double seconds = ( NowNs() - start ) / 1e9;
+    for( auto& instance : instances )
+    {
+        instance->Stop();
+    }
+
+    Latencies latency, wait, hold;
+    for( int i = 0; i < threads; ++i )
+    {
+        latency.Merge( latencies[ i ] );
+    }
+    for( auto& time : times )
+    {
+        wait.Merge( time.wait );
+        hold.Merge( time.hold );
+    }
+    report.Begin( "lock", "TimedLock" );
+    report.Add( "threads", threads );
+    report.Add( "instances", instanceCount );
+    report.Add( "wait_pct", waitPercent );
+    report.Add( "size", size );
+    report.Add( "msgs_per_s", threads * options.messages / seconds );
+    report.Add( "timeouts", static_cast<double>( timeouts ) );
+    report.Add( "frame_misses", TimedNode::Frames().Misses() + PeerNode::Frames().Misses() - misses );
+    report.Add( "lock_wait_p50", wait.Percentile( 0.50 ) / 1e3 );
+    report.Add( "lock_wait_p99", wait.Percentile( 0.99 ) / 1e3 );
+    report.Add( "lock_wait_p999", wait.Percentile( 0.999 ) / 1e3 );
+    report.Add( "lock_hold_p50", hold.Percentile( 0.50 ) / 1e3 );
+    report.Add( "lock_hold_p99", hold.Percentile( 0.99 ) / 1e3 );
+    report.Add( "lat_p50_us", latency.Percentile( 0.50 ) / 1e3 );
+    report.Add( "lat_p99_us", latency.Percentile( 0.99 ) / 1e3 );
+    report.Add( "lat_p999_us", latency.Percentile( 0.999 ) / 1e3 );
+    report.Print();
+}
+
+}  // namespace
+
+int main( int argc, char** argv )
+{
+    Options options;
+    options.threads = { 1, 2, 4, 8, 12 };
+    options.wait = { 0, 50, 100 };
+    options.sizes = { 16, 256 };
+    options.instances = { 1, 0 };
+    options.messages = 2000;
+    options.timeout = 1000;
+
+    for( int i = 1; i + 1 < argc; i += 2 )
+    {
+        std::string option = argv[ i ];
+        const char* value = argv[ i + 1 ];
+        if( option == "--threads" )
+        {
+            options.threads = ParseList( value );
+        }
+        else if( option == "--wait" )
+        {
+            options.wait = ParseList( value );
+        }
+        else if( option == "--sizes" )
+        {
+            options.sizes = ParseList( value );
+        }
+        else if( option == "--instances" )
+        {
+            options.instances = ParseList( value );
+        }
+        else if( option == "--messages" )
+        {
+            options.messages = atoi( value );
+        }
+        else if( option == "--timeout" )
+        {
+            options.timeout = static_cast<uint32_t>( atol( value ) );
+        }
+        else if( option == "--json" )
+        {
+            options.json = value;
+        }
+        else
+        {
+            fprintf( stderr, "Unknown option %s, see the top of ContentionHarness.cpp\n", option.c_str() );
+            return 2;
+        }
+    }
+
+    Report report( "contention" );
+    for( int instances : options.instances )
+    {
+        for( int size : options.sizes )
+        {
+            for( int wait : options.wait )
+            {
+                for( int threads : options.threads )
+                {
+                    // With one thread, one instance each is one instance.
+                    if( ( instances == 0 ) && ( threads == 1 ) && ( std::count( options.instances.begin(), options.instances.end(), 1 ) != 0 ) )
+                    {
+                        continue;
+                    }
+                    Run( threads, wait, size, instances ? instances : threads, options, report );
+                }
+            }
+        }
+    }
+    if( !options.json.empty() && !report.Write( options.json ) )
+    {
+        fprintf( stderr, "Couldn't write %s\n", options.json.c_str() );
+        return 1;
+    }
+    return 0;
+}
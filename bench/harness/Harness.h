@@ -0,0 +1,152 @@
+/**
+ * \file    Harness.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_BENCH_HARNESS_H
+#define ESF_BENCH_HARNESS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Shared by the harnesses, which unlike the micro-benchmarks measure whole runs of many threads so keep their own
+// timings. The heap is fine here, nothing in bench/ is built for a target.
+
+namespace esf_bench
+{
+/// \returns    A monotonic time in nanoseconds.
+inline uint64_t NowNs()
+{
+    return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+}
+
+/// \brief      Latency samples, in nanoseconds, of one thread or merged across threads.
+class Latencies
+{
+   public:
+    void Reserve( size_t count ) { samples_.reserve( count ); }
+    void Add( uint64_t ns ) { samples_.push_back( ns ); }
+    void Merge( const Latencies& other ) { samples_.insert( samples_.end(), other.samples_.begin(), other.samples_.end() ); }
+    size_t Count() const { return samples_.size(); }
+
+    /// \returns    The sample at or below which \p fraction (0..1) of them lie, 0 if there are none.
+    uint64_t Percentile( double fraction )
+    {
+        if( samples_.empty() )
+        {
+            return 0;
+        }
+        std::sort( samples_.begin(), samples_.end() );
+        size_t index = static_cast<size_t>( fraction * ( samples_.size() - 1 ) + 0.5 );
+        return samples_[ index ];
+    }
+
+   private:
+    std::vector<uint64_t> samples_;
+};
+
+/// \brief      Rows of named numbers, printed as a table as they are added and written out as a JSON array.
+class Report
+{
+   public:
+    struct Column
+    {
+        std::string key;
+        std::string value;
+        bool text;
+    };
+    typedef std::vector<Column> Row;
+
+    explicit Report( const char* name ) : name_( name ) {}
+
+    /// \brief      Starts a row with its text columns (such as the link), add its numbers with Add().
+    void Begin( const char* key, const std::string& value )
+    {
+        rows_.push_back( Row() );
+        Text( key, value );
+    }
+    void Text( const char* key, const std::string& value ) { rows_.back().push_back( Column{ key, value, true } ); }
+    void Add( const char* key, double value )
+    {
+        char text[ 32 ];
+        snprintf( text, sizeof( text ), "%.6g", value );
+        rows_.back().push_back( Column{ key, text, false } );
+    }
+
+    /// \brief      Prints the last row, with a header before the first.
+    void Print() const
+    {
+        const Row& row = rows_.back();
+        if( rows_.size() == 1 )
+        {
+            for( const auto& column : row )
+            {
+                printf( "%14s", column.key.c_str() );
+            }
+            printf( "\n" );
+        }
+        for( const auto& column : row )
+        {
+            printf( "%14s", column.value.c_str() );
+        }
+        printf( "\n" );
+        fflush( stdout );
+    }
+
+    /// \returns    False if \p path couldn't be written.
+    bool Write( const std::string& path ) const
+    {
+        FILE* file = fopen( path.c_str(), "w" );
+        if( file == nullptr )
+        {
+            return false;
+        }
+        fprintf( file, "{\n  \"harness\": \"%s\",\n  \"runs\": [\n", name_ );
+        for( size_t i = 0; i < rows_.size(); ++i )
+        {
+            fprintf( file, "    {" );
+            for( size_t j = 0; j < rows_[ i ].size(); ++j )
+            {
+                const Column& column = rows_[ i ][ j ];
+                fprintf( file, column.text ? "%s\"%s\": \"%s\"" : "%s\"%s\": %s", j ? ", " : "", column.key.c_str(), column.value.c_str() );
+            }
+            fprintf( file, "}%s\n", i + 1 < rows_.size() ? "," : "" );
+        }
+        fprintf( file, "  ]\n}\n" );
+        fclose( file );
+        return true;
+    }
+
+   private:
+    const char* name_;
+    std::vector<Row> rows_;
+};
+
+/// \returns    The comma separated numbers of \p text, e.g. "16,64,256".
+inline std::vector<int> ParseList( const char* text )
+{
+    std::vector<int> values;
+    const char* p = text;
+    while( *p != '\0' )
+    {
+        char* end;
+        long value = strtol( p, &end, 10 );
+        if( end == p )
+        {
+            break;
+        }
+        values.push_back( static_cast<int>( value ) );
+        p = ( *end == ',' ) ? end + 1 : end;
+    }
+    return values;
+}
+
+}  // namespace esf_bench
+
+#endif  // #ifndef ESF_BENCH_HARNESS_H
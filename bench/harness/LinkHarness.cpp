@@ -0,0 +1,326 @@
+/**
+ * \file    LinkHarness.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+// Two nodes, each with its own lock and frame pool, joined by a socketpair or a pty pair, each reading its end on its
+// own thread as it would a UART. Publishers on one node PublishWait() to the other for every combination of payload
+// size and publisher count, reporting messages/s, payload bytes/s, wire efficiency (payload bytes over all the bytes
+// sent both ways, ACKs included) and the PublishWait() latency percentiles.
+//
+// EmbeddedSerialFillerLinkHarness [--link socketpair|pty|both] [--baud <bits/s>] [--sizes 16,64,256,960]
+//                                 [--publishers 1,2,4,8] [--messages <per publisher>] [--timeout <ms>]
+//                                 [--json <file>]
+//
+// --baud paces the writes of both ends at 10 bits a byte (8N1), as a pty's own speed setting does nothing. 0, the
+// default, sends as fast as the link takes it.
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "../Payload.h"
+#include "Harness.h"
+
+using namespace esf;
+using namespace esf_bench;
+
+namespace
+{
+/// \brief      Gives each end its own statics, as if they were on different devices, with room for every publisher.
+template <int Side>
+struct LinkConfig : DefaultConfig
+{
+    static const size_t PENDING_ACKS = 16;
+    static const size_t FRAMES = 16;
+};
+
+const char* const TOPIC = "bench";
+
+/// \brief      One node on one end of the link.
+template <int Side>
+class Endpoint
+{
+   public:
+    typedef BasicEmbeddedSerialFiller<LinkConfig<Side> > Node;
+
+    Endpoint( int fd, uint32_t baud ) : fd_( fd ), nsPerByte_( baud ? 10000000000ull / baud : 0 ), nextFree_( 0 ), stop_( false ), wireBytes_( 0 ), received_( 0 ), receivedBytes_( 0 )
+    {
+        node_.txDataReady_ = etl::delegate<void( const typename Node::ByteArray& )>::template create<Endpoint, &Endpoint::Write>( *this );
+        node_.Subscribe( TOPIC, etl::delegate<void( typename Node::ByteArray& )>::template create<Endpoint, &Endpoint::OnData>( *this ) );
+    }
+
+    void Start() { reader_ = std::thread( &Endpoint::Read, this ); }
+
+    void Stop()
+    {
+        stop_ = true;
+        reader_.join();
+    }
+
+    Node node_;
+    uint64_t WireBytes() const { return wireBytes_; }
+    uint64_t Received() const { return received_; }
+    uint64_t ReceivedBytes() const { return receivedBytes_; }
+
+   private:
+    /// \brief      Called with the node's lock held, so one frame at a time, blocking as a UART driver would.
+    void Write( const typename Node::ByteArray& data )
+    {
+        size_t written = 0;
+        while( written < data.size() )
+        {
+            ssize_t count = write( fd_, data.data() + written, data.size() - written );
+            if( count <= 0 )
+            {
+                return;
+            }
+            written += count;
+        }
+        wireBytes_ += written;
+
+        if( nsPerByte_ != 0 )
+        {
+            // The frame has left once the line has clocked out it and whatever went before it.
+            uint64_t now = NowNs();
+            nextFree_ = ( nextFree_ > now ? nextFree_ : now ) + written * nsPerByte_;
+            std::this_thread::sleep_for( std::chrono::nanoseconds( nextFree_ - now ) );
+        }
+    }
+
+    void OnData( typename Node::ByteArray& data )
+    {
+        ++received_;
+        receivedBytes_ += data.size();
+    }
+
+    void Read()
+    {
+        typename Node::ByteArray rxData;
+        while( !stop_ )
+        {
+            pollfd fds = { fd_, POLLIN, 0 };
+            if( poll( &fds, 1, 10 ) <= 0 )
+            {
+                continue;
+            }
+            rxData.resize( rxData.max_size() );
+            ssize_t count = read( fd_, rxData.data(), rxData.size() );
+            if( count <= 0 )
+            {
+                break;
+            }
+            rxData.resize( count );
+            node_.GiveRxData( rxData );
+        }
+    }
+
+    int fd_;
+    uint64_t nsPerByte_;
+    uint64_t nextFree_;
+    std::atomic<bool> stop_;
+    std::thread reader_;
+    std::atomic<uint64_t> wireBytes_;
+    std::atomic<uint64_t> received_;
+    std::atomic<uint64_t> receivedBytes_;
+};
+
+/// \returns    False, with \p fds untouched, if a pty pair couldn't be opened.
+bool OpenPty( int fds[ 2 ] )
+{
+    int master = posix_openpt( O_RDWR | O_NOCTTY );
+    if( master < 0 )
+    {
+        return false;
+    }
+    int slave = -1;
+    if( ( grantpt( master ) == 0 ) && ( unlockpt( master ) == 0 ) )
+    {
+        slave = open( ptsname( master ), O_RDWR | O_NOCTTY );
+    }
+    if( slave < 0 )
+    {
+        close( master );
+        return false;
+    }
+    // No echo, line editing or translation of 0x0A and the like, the bytes go through as they are.
+    termios settings;
+    tcgetattr( slave, &settings );
+    cfmakeraw( &settings );
+    tcsetattr( slave, TCSANOW, &settings );
+    fds[ 0 ] = master;
+    fds[ 1 ] = slave;
+    return true;
+}
+
+struct Options
+{
+    std::vector<std::string> links;
+    uint32_t baud;
+    std::vector<int> sizes;
+    std::vector<int> publishers;
+    int messages;
+    uint32_t timeout;
+    std::string json;
+};
+
+/// \brief      One run, adding its row to \p report.
+bool Run( const std::string& link, int size, int publishers, const Options& options, Report& report )
+{
+    int fds[ 2 ];
+    if( link == "pty" ? !OpenPty( fds ) : ( socketpair( AF_UNIX, SOCK_STREAM, 0, fds ) != 0 ) )
+    {
+        fprintf( stderr, "Couldn't open a %s link: %s\n", link.c_str(), strerror( errno ) );
+        return false;
+    }
+
+    Endpoint<0> a( fds[ 0 ], options.baud );
+    Endpoint<1> b( fds[ 1 ], options.baud );
+    a.Start();
+    b.Start();
+
+    Endpoint<0>::Node::ByteArray payload;
+    MakePayload( payload, size, 10 );
+
+    std::atomic<bool> go( false );
+    std::atomic<uint64_t> timeouts( 0 );
+    std::vector<Latencies> latencies( publishers );
+    std::vector<std::thread> threads;
+    for( int i = 0; i < publishers; ++i )
+    {
+        threads.push_back( std::thread( [&, i]() {
+            latencies[ i ].Reserve( options.messages );
+            while( !go )
+            {
+                std::this_thread::yield();
+            }
+            for( int message = 0; message < options.messages; ++message )
+            {
+                uint64_t start = NowNs();
+                if( a.node_.PublishWait( TOPIC, payload, options.timeout ) == PublishResponse::SUCCESS )
+                {
+                    latencies[ i ].Add( NowNs() - start );
+                }
+                else
+                {
+                    ++timeouts;
+                }
+            }
+        } ) );
+    }
+
+    uint64_t start = NowNs();
+    go = true;
+    for( auto& thread : threads )
+    {
+        thread.join();
+    }
+    double seconds = ( NowNs() - start ) / 1e9;
+    a.Stop();
+    b.Stop();
+    close( fds[ 0 ] );
+    close( fds[ 1 ] );
+
+    Latencies all;
+    for( auto& latency : latencies )
+    {
+        all.Merge( latency );
+    }
+    uint64_t wire = a.WireBytes() + b.WireBytes();
+    report.Begin( "link", link );
+    report.Add( "size", size );
+    report.Add( "publishers", publishers );
+    report.Add( "messages", static_cast<double>( b.Received() ) );
+    report.Add( "timeouts", static_cast<double>( timeouts ) );
+    report.Add( "msgs_per_s", b.Received() / seconds );
+    report.Add( "bytes_per_s", b.ReceivedBytes() / seconds );
+    report.Add( "wire_eff", wire ? static_cast<double>( b.ReceivedBytes() ) / wire : 0.0 );
+    report.Add( "p50_us", all.Percentile( 0.50 ) / 1e3 );
+    report.Add( "p99_us", all.Percentile( 0.99 ) / 1e3 );
+    report.Add( "p999_us", all.Percentile( 0.999 ) / 1e3 );
+    report.Print();
+    return true;
+}
+
+}  // namespace
+
+int main( int argc, char** argv )
+{
+    Options options;
+    options.links = { "socketpair", "pty" };
+    options.baud = 0;
+    options.sizes.assign( SIZES, SIZES + sizeof( SIZES ) / sizeof( SIZES[ 0 ] ) );
+    options.publishers = { 1, 2, 4, 8 };
+    options.messages = 2000;
+    options.timeout = 1000;
+
+    for( int i = 1; i + 1 < argc; i += 2 )
+    {
+        std::string option = argv[ i ];
+        const char* value = argv[ i + 1 ];
+        if( option == "--link" )
+        {
+            options.links = ( std::string( value ) == "both" ) ? options.links : std::vector<std::string>( 1, value );
+        }
+        else if( option == "--baud" )
+        {
+            options.baud = static_cast<uint32_t>( atol( value ) );
+        }
+        else if( option == "--sizes" )
+        {
+            options.sizes = ParseList( value );
+        }
+        else if( option == "--publishers" )
+        {
+            options.publishers = ParseList( value );
+        }
+        else if( option == "--messages" )
+        {
+            options.messages = atoi( value );
+        }
+        else if( option == "--timeout" )
+        {
+            options.timeout = static_cast<uint32_t>( atol( value ) );
+        }
+        else if( option == "--json" )
+        {
+            options.json = value;
+        }
+        else
+        {
+            fprintf( stderr, "Unknown option %s, see the top of LinkHarness.cpp\n", option.c_str() );
+            return 2;
+        }
+    }
+
+    Report report( "link" );
+    for( const auto& link : options.links )
+    {
+        for( int size : options.sizes )
+        {
+            for( int publishers : options.publishers )
+            {
+                if( !Run( link, size, publishers, options, report ) )
+                {
+                    return 1;
+                }
+            }
+        }
+    }
+    if( !options.json.empty() && !report.Write( options.json ) )
+    {
+        fprintf( stderr, "Couldn't write %s\n", options.json.c_str() );
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,317 @@
+/**
+ * \file    NoiseHarness.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+// Goodput and recovery time of each way of getting a message across, over a LossyLink (sim/LossyLink.h) swept over
+// bit error rates:
+//     wait        PublishWait(), published again by the caller until acknowledged.
+//     reliable    PublishReliable(), resent by the node.
+//     stream      PublishStream(), resent from Poll(). Runs on the link's virtual clock alone, so is repeatable.
+// The other modes run the virtual clock in step with the OS clock, that PublishWait() times out on.
+//
+// EmbeddedSerialFillerNoiseHarness [--modes wait,reliable,stream] [--ber 0,1e-6,1e-5,1e-4,1e-3] [--size <bytes>]
+//                                  [--messages <count>] [--baud <bits/s>] [--latency <us>] [--timeout <ms>]
+//                                  [--seed <n>] [--json <file>]
+//
+// Goodput counts each payload once, however many times it arrived. Latency is from the first attempt to the
+// acknowledge (wait, reliable) or in order delivery (stream).
+
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "../Payload.h"
+#include "Harness.h"
+#include "LossyLink.h"
+
+using namespace esf;
+using namespace esf_bench;
+using namespace esf_sim;
+
+namespace
+{
+/// \brief      Gives each end its own statics, as if they were on different devices.
+template <int Side>
+struct NoiseConfig : DefaultConfig
+{
+};
+typedef BasicEmbeddedSerialFiller<NoiseConfig<0> > Sender;
+typedef BasicEmbeddedSerialFiller<NoiseConfig<1> > Receiver;
+typedef LossyLink<Sender, Receiver> Link;
+
+const char* const TOPIC = "bench";
+// Poll() units of the stream, in the virtual clock's us.
+const uint64_t TICK = 1000;
+
+struct Options
+{
+    std::vector<std::string> modes;
+    std::vector<double> bers;
+    int size;
+    int messages;
+    uint32_t baud;
+    uint32_t latency;
+    uint32_t timeout;
+    uint64_t seed;
+    std::string json;
+};
+
+/// \brief      Counts each payload once, by the message number in its first two bytes.
+class Counter
+{
+   public:
+    Counter( int messages ) : seen_( messages, false ), sentAt_( messages, 0 ), delivered_( 0 ), bytes_( 0 ), link_( nullptr ) {}
+
+    void OnData( Receiver::ByteArray& data )
+    {
+        size_t message = ( data[ 0 ] << 8 ) | data[ 1 ];
+        if( ( message < seen_.size() ) && !seen_[ message ] )
+        {
+            seen_[ message ] = true;
+            ++delivered_;
+            bytes_ += data.size();
+            if( link_ != nullptr )
+            {
+                latencies_.Add( ( link_->Now() - sentAt_[ message ] ) * 1000 );
+            }
+        }
+    }
+
+    std::vector<bool> seen_;
+    // Virtual times (us) sent, for the stream.
+    std::vector<uint64_t> sentAt_;
+    std::atomic<uint64_t> delivered_;
+    std::atomic<uint64_t> bytes_;
+    Latencies latencies_;
+    Link* link_;
+};
+
+void MakeMessage( Sender::ByteArray& payload, int size, int message )
+{
+    MakePayload( payload, size, 10 );
+    payload[ 0 ] = static_cast<uint8_t>( message >> 8 );
+    payload[ 1 ] = static_cast<uint8_t>( message );
+}
+
+/// \returns    Seconds taken, on the virtual clock.
+double RunStream( Link& link, Sender& sender, Receiver& receiver, Counter& counter, const Options& options, uint64_t& retries )
+{
+    ReliableStream txStream( 50 );
+    ReliableStream rxStream( 50 );
+    sender.AttachStream( &txStream );
+    receiver.AttachStream( &rxStream );
+    counter.link_ = &link;
+
+    Sender::ByteArray payload;
+    int next = 0;
+    // Give up after a simulated minute a message.
+    uint64_t giveUp = static_cast<uint64_t>( options.messages ) * 60000000ull;
+    while( ( counter.delivered_ < static_cast<uint64_t>( options.messages ) ) && ( link.Now() < giveUp ) )
+    {
+        while( next < options.messages )
+        {
+            MakeMessage( payload, options.size, next );
+            if( sender.PublishStream( TOPIC, payload ) != StatusCode::SUCCESS )
+            {
+                break;
+            }
+            counter.sentAt_[ next++ ] = link.Now();
+        }
+        link.Advance( TICK );
+        sender.Poll( 1 );
+        receiver.Poll( 1 );
+    }
+    retries = txStream.Retransmissions();
+    return link.Now() / 1e6;
+}
+
+/// \returns    Seconds taken.
+double RunAcknowledged( bool reliable, Link& link, Sender& sender, Counter& /* counter */, const Options& options, Latencies& latencies, uint64_t& retries )
+{
+    // Keep the virtual clock on the OS clock, delivering frames as they arrive.
+    std::atomic<bool> done( false );
+    uint64_t start = NowNs();
+    std::thread pump( [&]() {
+        while( !done )
+        {
+            link.AdvanceTo( ( NowNs() - start ) / 1000 );
+            std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+        }
+    } );
+
+    sender.SetRetransmissionTimeouts( options.timeout, options.timeout / 2, options.timeout * 8 );
+    Sender::ByteArray payload;
+    for( int message = 0; message < options.messages; ++message )
+    {
+        MakeMessage( payload, options.size, message );
+        uint64_t sent = NowNs();
+        // Up to 8 attempts either way, an unreachable link mustn't hang the run.
+        PublishResponse response = PublishResponse::TIMEOUT;
+        if( reliable )
+        {
+            response = sender.PublishReliable( TOPIC, payload, 7 );
+        }
+        else
+        {
+            for( int attempt = 0; ( attempt < 8 ) && ( response != PublishResponse::SUCCESS ); ++attempt )
+            {
+                retries += attempt ? 1 : 0;
+                response = sender.PublishWait( TOPIC, payload, options.timeout );
+            }
+        }
+        if( response == PublishResponse::SUCCESS )
+        {
+            latencies.Add( NowNs() - sent );
+        }
+    }
+    double seconds = ( NowNs() - start ) / 1e9;
+    done = true;
+    pump.join();
+    return seconds;
+}
+
+void Run( const std::string& mode, double ber, const Options& options, Report& report )
+{
+    ChannelModel model;
+    model.bitErrorRate = ber;
+    model.latency = options.latency;
+    model.baud = options.baud;
+
+    Sender sender;
+    Receiver receiver;
+    Link link( sender, receiver, model, options.seed );
+    Counter counter( options.messages );
+    receiver.Subscribe( TOPIC, etl::delegate<void( Receiver::ByteArray& )>::create<Counter, &Counter::OnData>( counter ) );
+
+    uint64_t retries = 0;
+    Latencies latencies;
+    double seconds;
+    if( mode == "stream" )
+    {
+        seconds = RunStream( link, sender, receiver, counter, options, retries );
+        latencies = counter.latencies_;
+    }
+    else
+    {
+        seconds = RunAcknowledged( mode == "reliable", link, sender, counter, options, latencies, retries );
+    }
+    // Resends by PublishReliable() are only seen on the wire.
+    ChannelStats toReceiver = link.ToB().Stats();
+    if( mode == "reliable" )
+    {
+        retries = toReceiver.frames - options.messages;
+    }
+
+    std::ostringstream text;
+    text << ber;
+    report.Begin( "mode", mode );
+    report.Text( "ber", text.str() );
+    report.Add( "size", options.size );
+    report.Add( "delivered", static_cast<double>( counter.delivered_ ) );
+    report.Add( "retries", static_cast<double>( retries ) );
+    report.Add( "bit_errors", static_cast<double>( toReceiver.bitErrors + link.ToA().Stats().bitErrors ) );
+    report.Add( "goodput_Bps", counter.bytes_ / seconds );
+    // Of the line rate, one way.
+    report.Add( "goodput_pct", options.baud ? 100.0 * counter.bytes_ / seconds / ( options.baud / 10.0 ) : 0.0 );
+    report.Add( "lat_p50_ms", latencies.Percentile( 0.50 ) / 1e6 );
+    report.Add( "lat_p99_ms", latencies.Percentile( 0.99 ) / 1e6 );
+    report.Add( "lat_max_ms", latencies.Percentile( 1.0 ) / 1e6 );
+    report.Print();
+}
+
+std::vector<std::string> ParseNames( const char* text )
+{
+    std::vector<std::string> names;
+    std::istringstream stream( text );
+    std::string name;
+    while( std::getline( stream, name, ',' ) )
+    {
+        names.push_back( name );
+    }
+    return names;
+}
+
+}  // namespace
+
+int main( int argc, char** argv )
+{
+    Options options;
+    options.modes = { "wait", "reliable", "stream" };
+    options.bers = { 0.0, 1e-6, 1e-5, 1e-4, 1e-3 };
+    options.size = 64;
+    options.messages = 200;
+    options.baud = 115200;
+    options.latency = 1000;
+    options.timeout = 50;
+    options.seed = 1;
+
+    for( int i = 1; i + 1 < argc; i += 2 )
+    {
+        std::string option = argv[ i ];
+        const char* value = argv[ i + 1 ];
+        if( option == "--modes" )
+        {
+            options.modes = ParseNames( value );
+        }
+        else if( option == "--ber" )
+        {
+            options.bers.clear();
+            for( const auto& ber : ParseNames( value ) )
+            {
+                options.bers.push_back( atof( ber.c_str() ) );
+            }
+        }
+        else if( option == "--size" )
+        {
+            options.size = atoi( value ) < 2 ? 2 : atoi( value );
+        }
+        else if( option == "--messages" )
+        {
+            options.messages = atoi( value ) > 65536 ? 65536 : atoi( value );
+        }
+        else if( option == "--baud" )
+        {
+            options.baud = static_cast<uint32_t>( atol( value ) );
+        }
+        else if( option == "--latency" )
+        {
+            options.latency = static_cast<uint32_t>( atol( value ) );
+        }
+        else if( option == "--timeout" )
+        {
+            options.timeout = static_cast<uint32_t>( atol( value ) );
+        }
+        else if( option == "--seed" )
+        {
+            options.seed = strtoull( value, nullptr, 0 );
+        }
+        else if( option == "--json" )
+        {
+            options.json = value;
+        }
+        else
+        {
+            fprintf( stderr, "Unknown option %s, see the top of NoiseHarness.cpp\n", option.c_str() );
+            return 2;
+        }
+    }
+
+    Report report( "noise" );
+    for( const auto& mode : options.modes )
+    {
+        for( double ber : options.bers )
+        {
+            Run( mode, ber, options, report );
+        }
+    }
+    if( !options.json.empty() && !report.Write( options.json ) )
+    {
+        fprintf( stderr, "Couldn't write %s\n", options.json.c_str() );
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,333 @@
+/**
+ * \file    ReplayHarness.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+// Replays a capture (see Capture.h) into a fresh node, to measure the receive path on real traffic. The capture is
+// mapped, not read, so replaying costs only the copy into the node's ByteArray that a UART driver would make anyway.
+//
+// EmbeddedSerialFillerReplayHarness --capture <file> [--direction rx|tx|both] [--timing fast|recorded]
+//                                   [--repeat <count>] [--synthesize <messages>] [--json <file>]
+//
+// --direction rx replays the chunks the captured node received, as it received them. tx replays the frames it sent,
+// as its peer would have received them. both does the two, in turn, so as not to interleave two streams.
+// --timing fast feeds the records back to back (--repeat times over); recorded keeps to the capture's timestamps and
+// reports how late each was fed.
+// --synthesize first writes <file> from a traffic mix of topics and sizes, chunked as a UART driver reads, in place of
+// a capture from the field.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <thread>
+
+#include "EmbeddedSerialFiller/Capture.h"
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "../Payload.h"
+#include "Harness.h"
+
+using namespace esf;
+using namespace esf_bench;
+
+namespace
+{
+struct Options
+{
+    std::string capture;
+    std::vector<std::string> directions;
+    std::string timing;
+    int repeat;
+    int synthesize;
+    std::string json;
+};
+
+/// \brief      A capture file mapped read only.
+class MappedFile
+{
+   public:
+    explicit MappedFile( const std::string& path ) : data_( nullptr ), size_( 0 )
+    {
+        int fd = open( path.c_str(), O_RDONLY );
+        struct stat status;
+        if( ( fd >= 0 ) && ( fstat( fd, &status ) == 0 ) && ( status.st_size > 0 ) )
+        {
+            void* data = mmap( nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+            if( data != MAP_FAILED )
+            {
+                madvise( data, status.st_size, MADV_SEQUENTIAL );
+                data_ = static_cast<const uint8_t*>( data );
+                size_ = status.st_size;
+            }
+        }
+        if( fd >= 0 )
+        {
+            close( fd );
+        }
+    }
+
+    ~MappedFile()
+    {
+        if( data_ != nullptr )
+        {
+            munmap( const_cast<uint8_t*>( data_ ), size_ );
+        }
+    }
+
+    const uint8_t* Data() const { return data_; }
+    size_t Size() const { return size_; }
+
+   private:
+    const uint8_t* data_;
+    size_t size_;
+};
+
+/// \brief      The ends used to synthesize a capture, in one thread.
+struct SynthConfig : DefaultConfig
+{
+    typedef NoLock Lock;
+};
+typedef BasicEmbeddedSerialFiller<SynthConfig> SynthNode;
+
+/// \brief      Writes a capture of a node hearing a peer publish a mix of topics and sizes at 115200 baud, replying
+///             now and then, with the bytes arriving in chunks of 1 to 64 as a UART driver reads them.
+class Synthesizer
+{
+   public:
+    explicit Synthesizer( FILE* file )
+        : file_( file ), writer_( CaptureWriter::Output::create<Synthesizer, &Synthesizer::Output>( *this ) ), time_( 0 ), random_( 12345 )
+    {
+        peer_.txDataReady_ = etl::delegate<void( const SynthNode::ByteArray& )>::create<Synthesizer, &Synthesizer::FromPeer>( *this );
+        node_.txDataReady_ = etl::delegate<void( const SynthNode::ByteArray& )>::create<Synthesizer, &Synthesizer::FromNode>( *this );
+    }
+
+    void Run( int messages )
+    {
+        static const char* const TOPICS[] = { "imu", "motor/left", "motor/right", "battery", "log" };
+        writer_.Begin();
+        CaptureTap<SynthNode> tap( node_, writer_, CaptureTap<SynthNode>::Clock::create<Synthesizer, &Synthesizer::Clock>( *this ) );
+        SynthNode::ByteArray payload;
+        for( int message = 0; message < messages; ++message )
+        {
+            // Mostly small telemetry, some larger.
+            MakePayload( payload, SIZES[ ( Next() % 8 ) < 6 ? Next() % 2 : 2 + Next() % 2 ], 10 );
+            peer_.Publish( TOPICS[ Next() % 5 ], payload );
+            while( !wire_.empty() )
+            {
+                size_t count = 1 + Next() % 64;
+                count = count < wire_.size() ? count : wire_.size();
+                SynthNode::ByteArray chunk( wire_.begin(), wire_.begin() + count );
+                wire_.erase( wire_.begin(), wire_.begin() + count );
+                // 10 bits a byte at 115200 baud.
+                time_ += static_cast<uint32_t>( count * 87 );
+                tap.GiveRxData( chunk );
+            }
+            if( ( message % 16 ) == 0 )
+            {
+                MakePayload( payload, 8, 10 );
+                node_.Publish( "command", payload );
+            }
+        }
+    }
+
+   private:
+    void Output( const uint8_t* data, size_t size ) { fwrite( data, 1, size, file_ ); }
+    void FromPeer( const SynthNode::ByteArray& frame ) { wire_.insert( wire_.end(), frame.begin(), frame.end() ); }
+    void FromNode( const SynthNode::ByteArray& ) {}
+    uint32_t Clock() { return time_; }
+
+    uint32_t Next()
+    {
+        random_ = random_ * 1103515245u + 12345u;
+        return random_ >> 16;
+    }
+
+    FILE* file_;
+    CaptureWriter writer_;
+    SynthNode node_;
+    SynthNode peer_;
+    std::vector<uint8_t> wire_;
+    uint32_t time_;
+    uint32_t random_;
+};
+
+/// \brief      The node replayed into, and what came out of it.
+class Replayer
+{
+   public:
+    Replayer() : messages_( 0 ), errors_( 0 ), txBytes_( 0 )
+    {
+        node_.txDataReady_ = etl::delegate<void( const ByteArray& )>::create<Replayer, &Replayer::OnTx>( *this );
+        node_.Subscribe( "*", etl::delegate<void( ByteArray& )>::create<Replayer, &Replayer::OnData>( *this ) );
+    }
+
+    void Feed( const uint8_t* data, size_t size )
+    {
+        // A chunk larger than the node's ByteArray is given in pieces.
+        while( size != 0 )
+        {
+            size_t count = size < rxData_.max_size() ? size : rxData_.max_size();
+            rxData_.assign( data, data + count );
+            if( node_.GiveRxData( rxData_ ) != StatusCode::SUCCESS )
+            {
+                ++errors_;
+            }
+            data += count;
+            size -= count;
+        }
+    }
+
+    uint64_t messages_;
+    uint64_t errors_;
+    uint64_t txBytes_;
+
+   private:
+    void OnTx( const ByteArray& frame ) { txBytes_ += frame.size(); }
+    void OnData( ByteArray& ) { ++messages_; }
+
+    EmbeddedSerialFiller node_;
+    ByteArray rxData_;
+};
+
+/// \brief      One replay, adding its row to \p report.
+void Run( const MappedFile& file, const std::string& direction, const Options& options, Report& report )
+{
+    CaptureReader reader( file.Data(), file.Size() );
+    Replayer replayer;
+    Latencies lag;
+    uint64_t records = 0;
+    uint64_t bytes = 0;
+    bool recorded = options.timing == "recorded";
+    int repeat = recorded ? 1 : options.repeat;
+
+    uint64_t start = NowNs();
+    for( int pass = 0; pass < repeat; ++pass )
+    {
+        reader.Rewind();
+        CaptureReader::Record record;
+        uint64_t firstTime = UINT64_MAX;
+        while( reader.Next( record ) )
+        {
+            if( ( direction != "both" ) && ( ( record.direction == CaptureDirection::RX ) != ( direction == "rx" ) ) )
+            {
+                continue;
+            }
+            if( recorded )
+            {
+                firstTime = firstTime == UINT64_MAX ? record.time : firstTime;
+                uint64_t due = start + ( record.time - firstTime ) * 1000;
+                uint64_t now = NowNs();
+                if( due > now )
+                {
+                    std::this_thread::sleep_for( std::chrono::nanoseconds( due - now ) );
+                }
+                lag.Add( NowNs() - due );
+            }
+            replayer.Feed( record.data, record.size );
+            ++records;
+            bytes += record.size;
+        }
+    }
+    double seconds = ( NowNs() - start ) / 1e9;
+
+    report.Begin( "direction", direction );
+    report.Text( "timing", options.timing );
+    report.Add( "records", static_cast<double>( records ) );
+    report.Add( "bytes", static_cast<double>( bytes ) );
+    report.Add( "messages", static_cast<double>( replayer.messages_ ) );
+    report.Add( "errors", static_cast<double>( replayer.errors_ ) );
+    report.Add( "ack_bytes", static_cast<double>( replayer.txBytes_ ) );
+    report.Add( "MB_per_s", bytes / seconds / 1e6 );
+    report.Add( "msgs_per_s", replayer.messages_ / seconds );
+    report.Add( "ns_per_byte", bytes ? seconds * 1e9 / bytes : 0.0 );
+    report.Add( "lag_p99_us", lag.Percentile( 0.99 ) / 1e3 );
+    report.Print();
+    if( reader.Truncated() )
+    {
+        fprintf( stderr, "The capture ends part way through a record, the rest was skipped.\n" );
+    }
+}
+
+}  // namespace
+
+int main( int argc, char** argv )
+{
+    Options options;
+    options.directions = { "rx", "tx" };
+    options.timing = "fast";
+    options.repeat = 1;
+    options.synthesize = 0;
+
+    for( int i = 1; i + 1 < argc; i += 2 )
+    {
+        std::string option = argv[ i ];
+        const char* value = argv[ i + 1 ];
+        if( option == "--capture" )
+        {
+            options.capture = value;
+        }
+        else if( option == "--direction" )
+        {
+            options.directions = std::vector<std::string>( 1, value );
+        }
+        else if( option == "--timing" )
+        {
+            options.timing = value;
+        }
+        else if( option == "--repeat" )
+        {
+            options.repeat = atoi( value ) < 1 ? 1 : atoi( value );
+        }
+        else if( option == "--synthesize" )
+        {
+            options.synthesize = atoi( value );
+        }
+        else if( option == "--json" )
+        {
+            options.json = value;
+        }
+        else
+        {
+            fprintf( stderr, "Unknown option %s, see the top of ReplayHarness.cpp\n", option.c_str() );
+            return 2;
+        }
+    }
+    if( options.capture.empty() )
+    {
+        fprintf( stderr, "No --capture given, see the top of ReplayHarness.cpp\n" );
+        return 2;
+    }
+
+    if( options.synthesize > 0 )
+    {
+        FILE* file = fopen( options.capture.c_str(), "wb" );
+        if( file == nullptr )
+        {
+            fprintf( stderr, "Couldn't write %s\n", options.capture.c_str() );
+            return 1;
+        }
+        Synthesizer( file ).Run( options.synthesize );
+        fclose( file );
+    }
+
+    MappedFile file( options.capture );
+    if( !CaptureReader( file.Data(), file.Size() ).Valid() )
+    {
+        fprintf( stderr, "%s isn't a capture\n", options.capture.c_str() );
+        return 1;
+    }
+    Report report( "replay" );
+    for( const auto& direction : options.directions )
+    {
+        Run( file, direction, options, report );
+    }
+    if( !options.json.empty() && !report.Write( options.json ) )
+    {
+        fprintf( stderr, "Couldn't write %s\n", options.json.c_str() );
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * \file    ScaleHarness.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+// A controller and hundreds of sensors in one process, as a StarNetwork (sim/StarNetwork.h): a controller node and a
+// sensor node per sensor, each pair on a LossyLink. Sensors publish readings and the controller publishes commands to
+// each. For every combination of sensor count and thread count, reports the messages delivered a wall clock second,
+// the CPU time a message and the memory a node.
+//
+// EmbeddedSerialFillerScaleHarness [--sensors 16,64,256,512] [--threads 1,4] [--duration <virtual ms>]
+//                                  [--size <reading bytes>] [--period <reading ms>] [--baud <bits/s>]
+//                                  [--latency <us>] [--ber <rate>] [--json <file>]
+//
+// Every controller node shares ControllerConfig's static lock and frame pool, as does every sensor node
+// SensorConfig's. With more than one thread, frame_misses and lost show what that costs; single threaded both should
+// stay 0 on a clean link.
+
+#include <malloc.h>
+#include <time.h>
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "Harness.h"
+#include "StarNetwork.h"
+
+using namespace esf;
+using namespace esf_bench;
+using namespace esf_sim;
+
+namespace
+{
+struct ControllerConfig : DefaultConfig
+{
+};
+struct SensorConfig : DefaultConfig
+{
+};
+typedef BasicEmbeddedSerialFiller<ControllerConfig> ControllerNode;
+typedef BasicEmbeddedSerialFiller<SensorConfig> SensorNode;
+typedef StarNetwork<ControllerNode, SensorNode> Network;
+
+struct Options
+{
+    std::vector<int> sensors;
+    std::vector<int> threads;
+    uint32_t duration;
+    Traffic traffic;
+    ChannelModel model;
+    std::string json;
+};
+
+/// \returns    The CPU time (ns) of every thread of the process so far.
+uint64_t CpuNs()
+{
+    timespec now;
+    clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &now );
+    return static_cast<uint64_t>( now.tv_sec ) * 1000000000ull + now.tv_nsec;
+}
+
+/// \returns    The heap in use, in bytes. Unlike the resident set, not hidden by memory freed by earlier runs.
+uint64_t HeapBytes() { return mallinfo2().uordblks; }
+
+uint32_t FrameMisses() { return ControllerNode::Frames().Misses() + SensorNode::Frames().Misses(); }
+
+/// \brief      One run, adding its row to \p report.
+void Run( int sensors, int threads, const Options& options, Report& report )
+{
+    uint64_t heap = HeapBytes();
+    uint32_t misses = FrameMisses();
+    Network network( sensors, options.model, 1, options.traffic );
+    uint64_t built = HeapBytes() - heap;
+
+    uint64_t cpu = CpuNs();
+    uint64_t start = NowNs();
+    network.Run( options.duration, threads );
+    double seconds = ( NowNs() - start ) / 1e9;
+    cpu = CpuNs() - cpu;
+    network.Flush();
+
+    StarStats stats = network.Stats();
+    uint64_t sent = stats.readingsSent + stats.commandsSent;
+    uint64_t received = stats.readingsReceived + stats.commandsReceived;
+    report.Begin( "topology", "star" );
+    report.Add( "sensors", sensors );
+    report.Add( "nodes", static_cast<double>( network.Nodes() ) );
+    report.Add( "threads", threads );
+    report.Add( "messages", static_cast<double>( received ) );
+    report.Add( "lost", static_cast<double>( sent - received ) );
+    report.Add( "msgs_per_s", received / seconds );
+    // Virtual seconds run a wall clock second, over 1 is faster than real time.
+    report.Add( "speed", options.duration / 1e3 / seconds );
+    report.Add( "cpu_ns_msg", received ? static_cast<double>( cpu ) / received : 0.0 );
+    report.Add( "node_bytes", ( sizeof( ControllerNode ) + sizeof( SensorNode ) ) / 2.0 );
+    // The nodes are allocated with the simulator's links and buffers, so this is node_bytes and theirs.
+    report.Add( "heap_per_node", static_cast<double>( built ) / network.Nodes() );
+    report.Add( "frame_misses", FrameMisses() - misses );
+    report.Print();
+}
+
+}  // namespace
+
+int main( int argc, char** argv )
+{
+    Options options;
+    options.sensors = { 16, 64, 256, 512 };
+    options.threads = { 1, 4 };
+    options.duration = 1000;
+    options.model.baud = 115200;
+    options.model.latency = 1000;
+
+    for( int i = 1; i + 1 < argc; i += 2 )
+    {
+        std::string option = argv[ i ];
+        const char* value = argv[ i + 1 ];
+        if( option == "--sensors" )
+        {
+            options.sensors = ParseList( value );
+        }
+        else if( option == "--threads" )
+        {
+            options.threads = ParseList( value );
+        }
+        else if( option == "--duration" )
+        {
+            options.duration = static_cast<uint32_t>( atol( value ) );
+        }
+        else if( option == "--size" )
+        {
+            options.traffic.readingSize = static_cast<size_t>( atol( value ) );
+        }
+        else if( option == "--period" )
+        {
+            options.traffic.readingPeriod = atol( value ) < 1 ? 1 : static_cast<uint32_t>( atol( value ) );
+        }
+        else if( option == "--baud" )
+        {
+            options.model.baud = static_cast<uint32_t>( atol( value ) );
+        }
+        else if( option == "--latency" )
+        {
+            options.model.latency = static_cast<uint32_t>( atol( value ) );
+        }
+        else if( option == "--ber" )
+        {
+            options.model.bitErrorRate = atof( value );
+        }
+        else if( option == "--json" )
+        {
+            options.json = value;
+        }
+        else
+        {
+            fprintf( stderr, "Unknown option %s, see the top of ScaleHarness.cpp\n", option.c_str() );
+            return 2;
+        }
+    }
+
+    Report report( "scale" );
+    for( int sensors : options.sensors )
+    {
+        for( int threads : options.threads )
+        {
+            Run( sensors, threads, options, report );
+        }
+    }
+    if( !options.json.empty() && !report.Write( options.json ) )
+    {
+        fprintf( stderr, "Couldn't write %s\n", options.json.c_str() );
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,19 @@
+/**
+ * \file    Probe.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+
+// Never linked, footprint.py reads the size of each array (with nm) as the size of the type it is named after. This
+// works the same for a cross compiler, where nothing built can be run.
+extern "C" {
+char esf_sizeof_EmbeddedSerialFiller[ sizeof( esf::EmbeddedSerialFiller ) ];
+char esf_sizeof_ByteArray[ sizeof( esf::ByteArray ) ];
+char esf_sizeof_TopicTable[ sizeof( esf::TopicTable ) ];
+char esf_sizeof_TopicTrie[ sizeof( esf::TopicTrie ) ];
+char esf_sizeof_ReliableStream[ sizeof( esf::ReliableStream ) ];
+char esf_sizeof_FragmentAssembler[ sizeof( esf::FragmentAssembler ) ];
+char esf_sizeof_TopicDictionary[ sizeof( esf::TopicDictionary ) ];
+}
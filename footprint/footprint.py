@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""Reports the RAM a configuration of Definitions.h costs, see footprint/CMakeLists.txt.
+
+Reads, for the objects of one configuration:
+    - The esf_sizeof_* arrays of Probe.cpp (with nm), giving the size of each type.
+    - Every static variable in RAM (with nm), such as the frame pool.
+    - The .ci call graphs written by GCC's -fcallgraph-info=su, giving the worst case stack depth below each of the
+      entry points. Callbacks are called through delegates, so aren't in the graph, they run on top of this depth.
+Exits with 1 if a budget given is exceeded.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+ENTRY_POINTS = ["GiveRxData", "PublishInternal", "PublishWait"]
+
+NODE_RE = re.compile(r'node: \{ title: "([^"]+)" label: "([^"]*)"')
+EDGE_RE = re.compile(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+# nm's types of variables in RAM: BSS, data, unique global (template statics) and weak objects.
+STATIC_TYPES = "bBdDuvV"
+# <address> <size> <type> <name>, symbols without a size have no second field.
+SYMBOL_RE = re.compile(r"^[0-9a-fA-F]+ ([0-9a-fA-F]+) (\w) (.+)$")
+STACK_RE = re.compile(r"\\n(\d+) bytes \(([a-z,]+)\)")
+
+
+def read_symbols(nm, objects):
+    """Returns [(name, size, type)] of every sized symbol."""
+    output = subprocess.run([nm, "-S", "-C"] + objects, check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+    symbols = []
+    for line in output.splitlines():
+        match = SYMBOL_RE.match(line)
+        if match:
+            symbols.append((match.group(3), int(match.group(1), 16), match.group(2)))
+    return symbols
+
+
+def read_call_graph(objects):
+    """Returns {title: (name, stack bytes, bounded, defined)} and {title: set(callee titles)}, merged across objects."""
+    nodes = {}
+    edges = {}
+    for obj in objects:
+        ci = os.path.splitext(obj)[0] + ".ci"
+        if not os.path.exists(ci):
+            continue
+        with open(ci) as f:
+            for line in f:
+                match = NODE_RE.search(line)
+                if match:
+                    title, label = match.groups()
+                    name = label.split("\\n")[0]
+                    if name.startswith(")"):
+                        # GCC loses the start of some template names, the (mangled) title will have to do.
+                        name = title
+                    stack = STACK_RE.search(label)
+                    if stack:
+                        nodes[title] = (name, int(stack.group(1)), stack.group(2) == "static", True)
+                    elif title not in nodes:
+                        # Defined in another object (or a library), no stack use known yet.
+                        nodes[title] = (name, 0, True, False)
+                    continue
+                match = EDGE_RE.search(line)
+                if match:
+                    edges.setdefault(match.group(1), set()).add(match.group(2))
+    return nodes, edges
+
+
+def worst_depth(title, nodes, edges, path):
+    """Returns (bytes, bounded, [titles]) of the deepest call chain from title, each function at most once."""
+    _, stack, bounded, _ = nodes.get(title, (title, 0, True, False))
+    deepest = (0, True, [])
+    for callee in edges.get(title, ()):
+        if callee in path:
+            # Recursion, e.g. PublishInternal() announcing a topic, is counted once.
+            continue
+        depth = worst_depth(callee, nodes, edges, path | {callee})
+        if depth[0] > deepest[0]:
+            deepest = depth
+    return stack + deepest[0], bounded and deepest[1], [title] + deepest[2]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--name", required=True, help="Name of the configuration")
+    parser.add_argument("--nm", default="nm")
+    parser.add_argument("--output", help="Also write the report here")
+    parser.add_argument("--node-budget", type=int, default=0, help="Largest sizeof(EmbeddedSerialFiller), 0 for no limit")
+    parser.add_argument("--static-budget", type=int, default=0, help="Most static RAM, 0 for no limit")
+    parser.add_argument("--stack-budget", type=int, default=0, help="Deepest stack of any entry point, 0 for no limit")
+    parser.add_argument("objects", nargs="+")
+    args = parser.parse_args()
+
+    lines = ["Footprint of configuration '{}'".format(args.name), ""]
+    symbols = read_symbols(args.nm, args.objects)
+
+    sizes = dict((name[len("esf_sizeof_"):], size) for name, size, _ in symbols if name.startswith("esf_sizeof_"))
+    lines.append("sizeof")
+    for name in sorted(sizes):
+        lines.append("  {:<40} {:>8}".format(name, sizes[name]))
+
+    statics = sorted(((size, name) for name, size, kind in symbols if kind in STATIC_TYPES and not name.startswith("esf_sizeof_")), reverse=True)
+    static_total = sum(size for size, _ in statics)
+    lines.append("")
+    lines.append("Static RAM (largest first)")
+    for size, name in statics:
+        if size >= 16:
+            lines.append("  {:<70} {:>8}".format(name, size))
+    lines.append("  {:<70} {:>8}".format("Total", static_total))
+
+    nodes, edges = read_call_graph(args.objects)
+    lines.append("")
+    lines.append("Worst case stack, excluding callbacks")
+    deepest = 0
+    for entry in ENTRY_POINTS:
+        roots = [title for title, (name, _, _, defined) in nodes.items() if defined and "::{}(".format(entry) in name]
+        if not roots:
+            lines.append("  {:<40} {:>8}".format(entry, "n/a"))
+            continue
+        for root in sorted(roots):
+            depth, bounded, chain = worst_depth(root, nodes, edges, {root})
+            deepest = max(deepest, depth)
+            lines.append("  {:<40} {:>8}{}".format(entry, depth, "" if bounded else " (dynamic, unbounded)"))
+            for title in chain:
+                name, stack, _, _ = nodes.get(title, (title, 0, True, False))
+                lines.append("      {:>6}  {}".format(stack, name))
+
+    failures = []
+    node = sizes.get("EmbeddedSerialFiller", 0)
+    if args.node_budget and node > args.node_budget:
+        failures.append("sizeof(EmbeddedSerialFiller) {} > budget {}".format(node, args.node_budget))
+    if args.static_budget and static_total > args.static_budget:
+        failures.append("static RAM {} > budget {}".format(static_total, args.static_budget))
+    if args.stack_budget and deepest > args.stack_budget:
+        failures.append("stack {} > budget {}".format(deepest, args.stack_budget))
+    lines.append("")
+    lines.extend("OVER BUDGET: " + failure for failure in failures)
+
+    report = "\n".join(lines) + "\n"
+    sys.stdout.write(report)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(report)
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
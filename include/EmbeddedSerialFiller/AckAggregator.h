@@ -0,0 +1,68 @@
+/**
+ * \file    AckAggregator.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_ACK_AGGREGATOR_H
+#define ESF_ACK_AGGREGATOR_H
+
+#include <cstdint>
+
+#include "EmbeddedSerialFiller/Definitions.h"
+
+namespace esf
+{
+/// \brief Collects the packet IDs of received PUBLISH packets so they can be acknowledged together.
+/// \details
+/// A block of acknowledges is a base packet ID, which is always acknowledged, plus a 16 bit map
+/// where bit n acknowledges the (n + 1)th packet ID after the base. Packet IDs skip 0, so the ID after
+/// 0xFF is 0x01.
+///
+/// Acknowledge bitmap packet structure:
+/// [ 0x4D, <base packet ID>, <bitmap MSB>, <bitmap LSB>, <CRC MSB>, <CRC LSB> ]
+/// A BROADCAST/PUBLISH carrying acknowledges (0x62/0x70) inserts the same block after its packet ID:
+/// [ 0x62/0x70, <packet ID>, <base packet ID>, <bitmap MSB>, <bitmap LSB>, <length of topic id>, ... ]
+class AckAggregator
+{
+   public:
+    static const uint8_t BLOCK_SIZE = 3;
+    static const uint8_t MAX_OFFSET = 16;
+
+    AckAggregator();
+
+    /// \brief      Sets how long (in the units given to Tick()) an acknowledge may be held back.
+    /// \details    0, the default, disables aggregation.
+    void SetDelay( uint32_t delay ) { delay_ = delay; }
+    uint32_t Delay() const { return delay_; }
+
+    /// \brief      Adds a packet ID to the pending block.
+    /// \returns    False if the ID can't be represented in the pending block, which must be taken first.
+    bool Add( uint8_t packetId );
+
+    bool Pending() const { return pending_; }
+
+    /// \brief      Advances the hold-back timer.
+    /// \returns    True if there are acknowledges whose delay has expired.
+    bool Tick( uint32_t elapsed );
+
+    /// \brief      Removes the pending block.
+    void Take( uint8_t& base, uint16_t& bitmap );
+
+    /// \returns    The packet ID \p count IDs after \p packetId, skipping the invalid ID of 0.
+    static uint8_t Advance( uint8_t packetId, uint8_t count );
+
+    /// \returns    True if \p packetId is acknowledged by the block.
+    static bool Contains( uint8_t base, uint16_t bitmap, uint8_t packetId );
+
+   private:
+    uint32_t delay_;
+    uint32_t timer_;
+    bool pending_;
+    uint8_t base_;
+    uint16_t bitmap_;
+};
+
+}  // namespace esf
+
+#endif  // #ifndef ESF_ACK_AGGREGATOR_H
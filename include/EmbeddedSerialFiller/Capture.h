@@ -0,0 +1,154 @@
+/**
+ * \file    Capture.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_CAPTURE_H
+#define ESF_CAPTURE_H
+
+#include <etl/delegate.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "EmbeddedSerialFiller/Definitions.h"
+
+namespace esf
+{
+/// \brief Which way a captured record went.
+enum class CaptureDirection : uint8_t
+{
+    TX = 0,  // An encoded frame passed to txDataReady_.
+    RX = 1,  // A chunk of bytes passed to GiveRxData().
+};
+
+/// \brief Writes a capture of the bytes a node sent and received, for replaying later (see CaptureReader).
+/// \details
+/// A capture is an 8 byte header followed by one record for each frame or chunk, all little endian:
+///
+/// Header: [ 'E', 'S', 'F', 'C', <version LSB>, <version MSB>, 0x00, 0x00 ]
+/// Record: [ <direction>, <time delta (LEB128)>, <size (LEB128)>, <data 1>, ..., <data n> ]
+///
+/// Times are in us, each the (wrapping, 32 bit) difference from the record before, so a record usually costs 3 bytes
+/// more than its data. Nothing is buffered: each Record() passes its header and then its data to the output, which
+/// must take both (a file, a ring buffer drained to flash). Not thread safe, see CaptureTap.
+class CaptureWriter
+{
+   public:
+    static const uint16_t VERSION = 1;
+    static const size_t HEADER_SIZE = 8;
+    /// \brief Largest record header: the direction and two 5 byte LEB128 numbers.
+    static const size_t MAX_RECORD_HEADER_SIZE = 11;
+
+    /// \brief      Receives the capture, in pieces, as it is written.
+    typedef etl::delegate<void( const uint8_t* data, size_t size )> Output;
+
+    explicit CaptureWriter( Output output );
+
+    /// \brief      Writes the capture header. Call once, before the first Record().
+    void Begin();
+
+    /// \brief      Writes a record of \p size bytes going \p direction at \p time (us).
+    void Record( CaptureDirection direction, uint32_t time, const uint8_t* data, size_t size );
+
+    uint32_t Records() const { return records_; }
+
+   private:
+    Output output_;
+    uint32_t lastTime_;
+    uint32_t records_;
+};
+
+/// \brief Reads the records of a capture held in memory (a mapped file, say), without copying them.
+class CaptureReader
+{
+   public:
+    /// \brief One record, its data pointing into the capture.
+    struct Record
+    {
+        CaptureDirection direction;
+        /// Time (us) since the first record's time base, no longer wrapping.
+        uint64_t time;
+        const uint8_t* data;
+        size_t size;
+    };
+
+    CaptureReader( const uint8_t* capture, size_t size );
+
+    /// \returns    False if the capture doesn't start with a header of a version this can read.
+    bool Valid() const { return valid_; }
+
+    /// \brief      Reads the next record.
+    /// \returns    False at the end of the capture, or at a record cut short (see Truncated()).
+    bool Next( Record& record );
+
+    /// \brief      Goes back to the first record.
+    void Rewind();
+
+    /// \returns    True if reading stopped at a partial record, as a capture cut off mid-write ends.
+    bool Truncated() const { return truncated_; }
+
+   private:
+    bool ReadNumber( uint32_t& value );
+
+    const uint8_t* capture_;
+    size_t size_;
+    size_t position_;
+    uint64_t time_;
+    bool valid_;
+    bool truncated_;
+};
+
+/// \brief Captures everything a node sends and receives: wraps its txDataReady_, and stands in for its GiveRxData().
+/// \details
+/// Construct once the node's txDataReady_ is set, and pass received bytes to the tap's GiveRxData() in place of the
+/// node's. \p Lock (see LockPolicy.h, one of its own) serialises the records of the two directions, for where they
+/// are on different threads. It is only held while writing, so never nests the other way round to the node's lock.
+template <typename Node, typename Lock = NoLock>
+class CaptureTap
+{
+   public:
+    /// \brief      The time now, in us.
+    typedef etl::delegate<uint32_t()> Clock;
+
+    CaptureTap( Node& node, CaptureWriter& writer, Clock clock ) : node_( node ), writer_( writer ), clock_( clock ), txDataReady_( node.txDataReady_ )
+    {
+        lock_.Create();
+        node_.txDataReady_ = etl::delegate<void( const typename Node::ByteArray& )>::template create<CaptureTap, &CaptureTap::OnTx>( *this );
+    }
+
+    ~CaptureTap() { node_.txDataReady_ = txDataReady_; }
+
+    StatusCode GiveRxData( IByteArray& rxData )
+    {
+        {
+            typename Lock::Guard guard( lock_, true );
+            writer_.Record( CaptureDirection::RX, clock_(), rxData.data(), rxData.size() );
+        }
+        return node_.GiveRxData( rxData );
+    }
+
+   private:
+    void OnTx( const typename Node::ByteArray& frame )
+    {
+        {
+            typename Lock::Guard guard( lock_, true );
+            writer_.Record( CaptureDirection::TX, clock_(), frame.data(), frame.size() );
+        }
+        if( txDataReady_.is_valid() )
+        {
+            txDataReady_( frame );
+        }
+    }
+
+    Node& node_;
+    CaptureWriter& writer_;
+    Clock clock_;
+    etl::delegate<void( const typename Node::ByteArray& )> txDataReady_;
+    Lock lock_;
+};
+
+}  // namespace esf
+
+#endif  // #ifndef ESF_CAPTURE_H
@@ -15,16 +15,18 @@ class CobsTranscoder
 {
    public:
     /// \details    The encoding process cannot fail.
-    static void Encode( const ByteArray& rawData, ByteArray& encodedData );
+    static void Encode( const IByteArray& rawData, IByteArray& encodedData );
     /// \brief An alternate implementation, optimised for performance.
     /// This is ~30% faster.
-    static void Encode( const uint8_t* rawData, size_t length, uint8_t* encodedData );
+    /// \details    \p encodedData needs room for 2 + length + length / 254 bytes, the worst case.
+    /// \returns    The number of bytes encoded, including the terminating 0x00.
+    static size_t Encode( const uint8_t* rawData, size_t length, uint8_t* encodedData );
 
     /// \brief      Decode data using "Consistent Overhead Byte Stuffing" (COBS).
     /// \details    Provided encodedData is expected to be a single, valid COBS encoded packet. If not, method
     ///             will return #DecodeStatus::ERROR_ZERO_BYTE_NOT_EXPECTED.
     ///             #decodedData is emptied of any pre-existing data. If the decode fails, decodedData is left empty.
-    static StatusCode Decode( const ByteArray& encodedData, ByteArray& decodedData );
+    static StatusCode Decode( const IByteArray& encodedData, IByteArray& decodedData );
     /// \brief An alternate implementation, optimised for performance.
     static StatusCode Decode( const uint8_t* encodedData, size_t length, uint8_t* decodedData );
 };
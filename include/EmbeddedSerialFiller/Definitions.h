@@ -10,6 +10,8 @@
 #include <etl/string.h>
 #include <etl/vector.h>
 
+#include "EmbeddedSerialFiller/LockPolicy.h"
+
 #ifndef ESF_MAX_PACKET_SIZE
 #define ESF_MAX_PACKET_SIZE 1024
 #endif
@@ -22,6 +24,72 @@
 #ifndef ESF_MAX_PENDING_ACKS
 #define ESF_MAX_PENDING_ACKS 8
 #endif
+// Retransmission timeout limits for PublishReliable(), in ms (or call cycles for PROFILE_NO_RTOS).
+#ifndef ESF_RTO_INITIAL
+#define ESF_RTO_INITIAL 1000
+#endif
+#ifndef ESF_RTO_MIN
+#define ESF_RTO_MIN 10
+#endif
+#ifndef ESF_RTO_MAX
+#define ESF_RTO_MAX 10000
+#endif
+#ifndef ESF_LATENCY_BITS
+// Round trip times up to 2^ESF_LATENCY_BITS - 1 are told apart by a LatencyHistogram, longer ones are lumped together.
+#define ESF_LATENCY_BITS 16
+#endif
+#ifndef ESF_LATENCY_SUB_BITS
+// Each power of two of a LatencyHistogram is split into 2^ESF_LATENCY_SUB_BITS buckets, so a percentile is read to
+// within 1 part in 2^ESF_LATENCY_SUB_BITS.
+#define ESF_LATENCY_SUB_BITS 3
+#endif
+#ifndef ESF_STREAM_WINDOW_SIZE
+// Number of unacknowledged frames a ReliableStream may have in flight.
+#define ESF_STREAM_WINDOW_SIZE 4
+#endif
+#ifndef ESF_MAX_TOPIC_IDS
+// Number of topics a TopicDictionary can assign IDs to, in each direction (no more than 64).
+#define ESF_MAX_TOPIC_IDS 16
+#endif
+#ifndef ESF_TOPIC_ANNOUNCE_RETRY
+// An unconfirmed topic is announced again every this many uses.
+#define ESF_TOPIC_ANNOUNCE_RETRY 8
+#endif
+#ifndef ESF_MAX_WILDCARDS
+// Number of distinct wildcard patterns ("motor/*") that can be subscribed to.
+#define ESF_MAX_WILDCARDS 4
+#endif
+#ifndef ESF_MAX_TRIE_NODES
+// Number of characters shared between all wildcard patterns, one trie node each.
+#define ESF_MAX_TRIE_NODES 64
+#endif
+#ifndef ESF_MAX_RX_DEPTH
+// Number of GiveRxData() calls that may be in progress at once on the nodes of a Config, from different threads or
+// nested through callbacks and loopbacks. Only used to size ESF_FRAME_POOL_SIZE.
+#define ESF_MAX_RX_DEPTH 3
+#endif
+#ifndef ESF_FRAME_POOL_SIZE
+// Number of packet buffers shared by the receive and transmit paths, see FramePool.h. Each GiveRxData() holds two and
+// the transmit that fed it one, with two more to build the innermost packet.
+#define ESF_FRAME_POOL_SIZE ( 3 * ESF_MAX_RX_DEPTH + 2 )
+#endif
+#if ESF_FRAME_POOL_SIZE < 4
+#error A received PUBLISH needs at least 4 frames to be acknowledged, two for the packet and two to build its ACK.
+#endif
+#ifndef ESF_FRAGMENT_SIZE
+// Maximum number of data bytes in each fragment sent by PublishLarge().
+#define ESF_FRAGMENT_SIZE 256
+#endif
+
+#ifndef ESF_PROFILER_TOPICS
+// Number of topics a TopicProfiler keeps counts for.
+#define ESF_PROFILER_TOPICS 16
+#endif
+#if !defined( ESF_PROFILER_CLOCK ) && defined( ESF_CLOCK_US )
+// The TopicProfiler's clock, microseconds by default. Define it as a cycle counter for finer times, or where the
+// abstraction layer has no ESF_CLOCK_US().
+#define ESF_PROFILER_CLOCK() ESF_CLOCK_US()
+#endif
 
 #define ESF_OPTIMISE // Optimisation is on by default.
 
@@ -32,12 +100,21 @@
 //#define ESF_MINIMAL_IMPLEMENTATION
 #endif
 
+// Uncomment (or define in the build) to enable AttachProfiler(), see TopicProfiler.h.
+//#define ESF_TOPIC_PROFILER
+
+// Uncomment (or define in the build) to make the tracepoints USDT probes, or define ESF_TRACE() to hook them yourself,
+// see Tracepoints.h.
+//#define ESF_USDT
+
 // This disallows partial packet receptions.
 //#define ESF_REJECT_INCOMPLETE_PACKETS
 
 namespace esf
 {
     using ByteArray = etl::vector<uint8_t, ESF_MAX_PACKET_SIZE>;
+    /// \brief A ByteArray of any capacity, see BasicEmbeddedSerialFiller.
+    using IByteArray = etl::ivector<uint8_t>;
     using ByteQueue = ByteArray;
     using Topic = etl::string<ESF_MAX_TOPIC_LENGTH>;
 
@@ -48,9 +125,17 @@ namespace esf
     enum class PacketType : uint8_t
     {
         UNKNOWN = 0x0,
-        BROADCAST = 0x42, /* 'B' No response expected */
-        ACK = 0x41,       /* 'A' Acknowledge */
-        PUBLISH = 0x50,   /* 'P' Expects an ACK response */
+        BROADCAST = 0x42,      /* 'B' No response expected */
+        ACK = 0x41,            /* 'A' Acknowledge */
+        PUBLISH = 0x50,        /* 'P' Expects an ACK response */
+        ACK_BITMAP = 0x4D,     /* 'M' Acknowledges a block of packet IDs (see AckAggregator) */
+        BROADCAST_ACKS = 0x62, /* 'b' BROADCAST carrying a block of acknowledges */
+        PUBLISH_ACKS = 0x70,   /* 'p' PUBLISH carrying a block of acknowledges */
+        STREAM = 0x53,         /* 'S' Sequenced, expects a STREAM_ACK response (see ReliableStream) */
+        STREAM_ACK = 0x73,     /* 's' Selective acknowledge of a single STREAM sequence number */
+        FRAGMENT = 0x46,       /* 'F' Part of a message too large for a single packet (see FragmentAssembler) */
+        TOPIC_ANNOUNCE = 0x54, /* 'T' Assigns a numeric ID to a topic (see TopicDictionary) */
+        TOPIC_ACK = 0x74,      /* 't' Confirms (or rejects) a topic ID */
     };
 
     /**
@@ -63,6 +148,7 @@ namespace esf
         SUCCESS,
         PENDING,
         TIMEOUT,
+        NOT_SENT, /* No frame was free to build the packet in, see FramePool.h */
     };
 
     /**
@@ -80,6 +166,12 @@ namespace esf
         ERROR_UNRECOGNISED_SUBSCRIBER,
         ERROR_ZERO_BYTE_NOT_EXPECTED,
         ERROR_RX_DATA_BUFFER_FULL,
+        ERROR_STREAM_NOT_ATTACHED,
+        ERROR_STREAM_WINDOW_FULL,
+        ERROR_ASSEMBLER_NOT_ATTACHED,
+        ERROR_MESSAGE_TOO_LARGE,
+        ERROR_UNKNOWN_TOPIC_ID,
+        ERROR_NO_FREE_FRAMES,
 #if defined(ESF_REJECT_INCOMPLETE_PACKETS)
         ERROR_PACKET_INCOMPLETE,
 #endif
@@ -87,6 +179,42 @@ namespace esf
 
 #define ESF_MIN_BYTES (3)
 
+// Marks a StaticTopic ID (0xC0 | <ID>) in place of the topic length.
+#define ESF_STATIC_TOPIC_FLAG (0xC0)
+
+    /// \brief Dispatches a received StaticTopic, see StaticRegistry.
+    typedef bool ( *StaticDispatch )( uint8_t topicId, const uint8_t* data, size_t size );
+
+    /**
+ * \struct DefaultConfig
+ * \brief The capacities of an EmbeddedSerialFiller. Derive from this, hiding whichever
+ *        constants a link needs smaller (or larger), to size a BasicEmbeddedSerialFiller.
+ */
+    struct DefaultConfig
+    {
+        /// Largest packet once COBS encoded, sizing the node's ByteArray and every packet buffer.
+        static const size_t PACKET_SIZE = ESF_MAX_PACKET_SIZE;
+        /// Received bytes held until a whole packet has arrived.
+        static const size_t RX_BUFFER_SIZE = ESF_MAX_PACKET_SIZE;
+        /// Topics that may be subscribed to.
+        static const size_t TOPICS = ESF_MAX_SUBSCRIBERS;
+        /// Subscribers to each topic.
+        static const size_t SUBSCRIBERS = ESF_MAX_SUBSCRIBERS;
+        /// PublishWait()/PublishReliable() calls that may be waiting at once (RTOS builds only).
+        static const size_t PENDING_ACKS = ESF_MAX_PENDING_ACKS;
+        /// Packet buffers shared by every node with this Config, see FramePool.h.
+        static const size_t FRAMES = ESF_FRAME_POOL_SIZE;
+        /// Range and precision of the ACK round trip time histogram, see LatencyHistogram.h.
+        static const size_t LATENCY_BITS = ESF_LATENCY_BITS;
+        static const size_t LATENCY_SUB_BITS = ESF_LATENCY_SUB_BITS;
+        /// Guards the node's state, see LockPolicy.h. NoLock for a node only used from one thread (RTOS builds only).
+#if defined(PROFILE_NO_RTOS)
+        typedef NoLock Lock;
+#else
+        typedef MutexLock Lock;
+#endif
+    };
+
 } // namespace esf
 
 #endif // #ifndef ESF_DEFINITIONS_H
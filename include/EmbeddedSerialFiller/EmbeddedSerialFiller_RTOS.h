@@ -13,7 +13,19 @@
 #include <cstdint>
 #include <iostream>
 
+#include "EmbeddedSerialFiller/AckAggregator.h"
 #include "EmbeddedSerialFiller/Definitions.h"
+#include "EmbeddedSerialFiller/FragmentAssembler.h"
+#include "EmbeddedSerialFiller/FramePool.h"
+#include "EmbeddedSerialFiller/LatencyHistogram.h"
+#include "EmbeddedSerialFiller/LinkStats.h"
+#include "EmbeddedSerialFiller/ReliableStream.h"
+#include "EmbeddedSerialFiller/RttEstimator.h"
+#include "EmbeddedSerialFiller/TopicDictionary.h"
+#include "EmbeddedSerialFiller/TopicProfiler.h"
+#include "EmbeddedSerialFiller/TopicTable.h"
+#include "EmbeddedSerialFiller/TopicTrie.h"
+#include "EmbeddedSerialFiller/Tracepoints.h"
 #include "esf_abstraction.h"
 
 namespace esf
@@ -27,31 +39,141 @@ namespace esf
 /// [ 0x01/0x04, <packet ID>, <length of topic id>, <topic ID 1>, ..., <topic ID n>, <data 1>, ... , <data n>, <CRC MSB>, <CRC LSB> ]
 /// Acknowledge packet Structure:
 /// [ 0x02, <packet ID>, <CRC MSB>, <CRC LSB> ]
+/// Acknowledge bitmap packets, and data packets carrying acknowledges, are described in AckAggregator.h.
+/// Stream and stream acknowledge packets are described in ReliableStream.h.
 ///
 /// This is then COBS encoded, which frames the end-of-packet with a unique 0x00 byte,
 /// and escapes all pre-existing 0x00's present in packet.
-class EmbeddedSerialFiller
+///
+/// The node's buffers and tables are sized by \p Config (see DefaultConfig), so each link in a firmware can be
+/// given only what its traffic needs. Its ByteArray holds Config::PACKET_SIZE bytes, and is the type taken by
+/// Publish(), subscribers and txDataReady_. EmbeddedSerialFiller is the DefaultConfig node.
+template <typename Config = DefaultConfig>
+class BasicEmbeddedSerialFiller
 {
    public:
+    /// \brief      Holds the packets, and the data published or received, of this node.
+    typedef etl::vector<uint8_t, Config::PACKET_SIZE> ByteArray;
+    typedef BasicTopicTable<Config::TOPICS, Config::SUBSCRIBERS, ByteArray> TopicTable;
+    typedef BasicTopicTrie<TopicTable> TopicTrie;
+    typedef BasicFramePool<ByteArray, Config::FRAMES> FramePool;
+    typedef BasicReliableStream<Config::PACKET_SIZE> ReliableStream;
+    typedef BasicLatencyHistogram<Config::LATENCY_BITS, Config::LATENCY_SUB_BITS> LatencyHistogram;
+
+    /// \brief      The most data PublishLarge() puts in a fragment, ESF_FRAGMENT_SIZE unless that wouldn't fit a packet.
+    static const size_t FRAGMENT_SIZE = FragmentAssembler::FragmentSize( Config::PACKET_SIZE );
+
     /// \brief      Basic constructor.
-    EmbeddedSerialFiller();
+    BasicEmbeddedSerialFiller();
 
     /// \brief      Publishes data on a topic, and then immediately returns. Does not block (see PublishWait()).
+    /// \returns    The packet ID used, or 0 if no frame was free to build the packet in (see FramePool.h).
     uint8_t Publish( const Topic& topic, const ByteArray& data );
 
+    /// \brief      Prepares a topic for repeated use with the TopicHandle overloads of Publish(), Subscribe()
+    ///             and Unsubscribe().
+    static TopicHandle RegisterTopic( const Topic& topic );
+
+    /// \brief      As Publish(), with a topic from RegisterTopic().
+    uint8_t Publish( const TopicHandle& topic, const ByteArray& data );
+
     /// \brief      Publishes data on a topic, and then blocks the calling thread until either an acknowledge
     ///             is received, or a timeout occurs.
     /// \returns    True if an acknowledge was received before the timeout occurred, otherwise false.
+    ///             NOT_SENT, without waiting, if no frame was free to build the packet in.
     PublishResponse PublishWait( const Topic& topic, const ByteArray& data, size_t timeout );
 
+    /// \brief      Publishes data on a topic, and then blocks the calling thread until an acknowledge is received,
+    ///             resending the packet each time the retransmission timeout expires, up to \p maxRetransmits times.
+    /// \details    The timeout adapts to the round trip times measured by PublishWait() and PublishReliable()
+    ///             (see RttEstimator) and doubles after each retransmission. As a resent packet may have arrived
+    ///             and only its ACK been lost, the remote subscribers may see it more than once. NOT_SENT is
+    ///             returned, without waiting, if no frame was free to build the first copy in.
+    PublishResponse PublishReliable( const Topic& topic, const ByteArray& data, uint8_t maxRetransmits );
+
+    /// \brief      Sets the initial retransmission timeout and its bounds (in ms), discarding the measured round trip time.
+    void SetRetransmissionTimeouts( uint32_t initialRto, uint32_t minRto, uint32_t maxRto );
+
+    /// \returns    The round trip time measured for this link.
+    RttEstimator RoundTripTime();
+
+    /// \returns    The round trip times of the ACKs to PublishWait() and PublishReliable() since the last
+    ///             ResetAckLatency(), the same samples as RoundTripTime() (so not those of resent packets).
+    /// \details    For p50/p90/p99 use Percentile( 50 ) and so on. Timeouts are counted by Stats().ackTimeouts.
+    LatencyHistogram AckLatency();
+
+    /// \brief      Empties the AckLatency() histogram, to start a new period.
+    void ResetAckLatency();
+
+    /// \brief      Attaches a ReliableStream of this node's packet size, enabling PublishStream() and the reception of
+    ///             STREAM packets.
+    /// \details    Pass nullptr to detach. Both ends of the link must have a stream attached.
+    void AttachStream( ReliableStream* stream );
+
+    /// \brief      Publishes data on the attached stream and returns immediately. The frame is resent from
+    ///             Poll() until it is acknowledged, and is delivered to the remote subscribers in order.
+    /// \returns    #StatusCode::ERROR_STREAM_WINDOW_FULL if ESF_STREAM_WINDOW_SIZE frames are unacknowledged.
+    StatusCode PublishStream( const Topic& topic, const ByteArray& data );
+
+    /// \brief      Attaches a TopicDictionary, so that topics are sent as single byte IDs once the remote
+    ///             node has learnt them. Pass nullptr to go back to sending topic strings.
+    /// \details    IDs announced by the remote node are only understood while a dictionary is attached.
+    void AttachDictionary( TopicDictionary* dictionary );
+
+    /// \brief      Sets the function that handles received StaticTopic's, normally via StaticRegistry::Attach().
+    void AttachRegistry( StaticDispatch dispatch );
+
+    /// \brief      Broadcasts a StaticTopic's payload, normally via StaticRegistry::Publish().
+    /// \returns    The packet ID used, or 0 if no frame was free to build the packet in.
+    uint8_t PublishStatic( uint8_t topicId, const uint8_t* data, size_t size );
+
+#if defined( ESF_TOPIC_PROFILER )
+    /// \brief      Attaches a TopicProfiler, which counts each received topic's messages and times its callbacks.
+    /// \details    Pass nullptr to detach.
+    void AttachProfiler( TopicProfiler* profiler );
+#endif
+
+    /// \brief      Attaches a FragmentAssembler, enabling the reception of messages sent with PublishLarge().
+    /// \details    Pass nullptr to detach.
+    void AttachAssembler( FragmentAssembler* assembler );
+
+    /// \brief      Publishes a message of any size up to 65535 * FRAGMENT_SIZE bytes, split into fragments
+    ///             that are sent back to back. Does not block or wait for an acknowledge.
+    /// \details    The remote node must have a FragmentAssembler attached, with a buffer large enough for the message.
+    /// \returns    #StatusCode::ERROR_MESSAGE_TOO_LARGE if the message needs more than 65535 fragments, or the
+    ///             node's packets are too small to hold a fragment (FRAGMENT_SIZE is 0).
+    StatusCode PublishLarge( const Topic& topic, const uint8_t* data, size_t size );
+
+    /// \brief      Sets how long acknowledges of received PUBLISH packets may be held back, in Poll() units.
+    /// \details    Held back acknowledges are sent together in a single ACK_BITMAP packet once the delay expires,
+    ///             or ride along with the next BROADCAST/PUBLISH sent, whichever is first. 0 (the default) sends an
+    ///             ACK for every PUBLISH immediately, as expected by nodes that predate ACK_BITMAP.
+    ///             The remote node's PublishWait() timeout must allow for the delay.
+    void SetAckDelay( uint32_t delay );
+
+    /// \brief      Call periodically to advance the retransmission and acknowledge timers by \p elapsed
+    ///             (in the units of the stream's retransmit timeout and SetAckDelay()), resending any stream
+    ///             frames and held back acknowledges that have expired.
+    void Poll( uint32_t elapsed );
+
     /// \brief      Call to subscribe to a particular topic.
-    /// \returns    A unique subscription ID which can be used to delete the subsriber.
+    /// \details    A topic ending in '*' is a wildcard, subscribing to every topic starting with the characters
+    ///             before it (see TopicTrie). Subscribers to both a topic and a matching wildcard are all called.
+    /// \returns    A unique subscription ID which can be used to delete the subsriber, or TopicTable::INVALID_ID
+    ///             if Config::TOPICS topics, or Config::SUBSCRIBERS to this topic, already exist (ESF_MAX_WILDCARDS
+    ///             or ESF_MAX_TRIE_NODES for wildcards).
     uint32_t Subscribe( const Topic& topic, etl::delegate<void( ByteArray& )> callback );
 
+    /// \brief      As Subscribe(), with a topic from RegisterTopic().
+    uint32_t Subscribe( const TopicHandle& topic, etl::delegate<void( ByteArray& )> callback );
+
     /// \brief      Unsubscribes a subscriber using the provided ID.
     /// \details    ID is returned from #Subscribe() method.
     StatusCode Unsubscribe( uint32_t subscriberId );
 
+    /// \brief      Unsubscribes every subscriber of a topic from RegisterTopic().
+    StatusCode Unsubscribe( const TopicHandle& topic );
+
     /// \brief      Unsubscribes all subscribers.
     void UnsubscribeAll();
 
@@ -59,11 +181,13 @@ class EmbeddedSerialFiller
     /// \details    EmbeddedSerialFiller will add this data to it's internal RX data buffer, and then
     ///             attempt to find and extract valid packets. If EmbeddedSerialFiller finds valid packets,
     ///             it will then call all callbacks associated with that topic.
-    StatusCode GiveRxData( ByteArray& rxData );
+    StatusCode GiveRxData( IByteArray& rxData );
 
     /// \brief      Use to enable/disable thread safety (enabled by default). Enabling thread safety makes all EmbeddedSerialFiller API
     ///             methods take out a lock on enter, and release on exit. PublishWait() releases lock when it blocks (so
     ///             PublishWait() can be called multiple times from different threads).
+    /// \details    Only the default MutexLock policy can be switched at run time. A node only used from one thread
+    ///             should rather have a Config with a NoLock policy, which leaves no lock or branch behind at all.
     void SetThreadSafetyEnabled( bool value );
 
     /// \brief      Call to find out how many threads are currently waiting on ACKs for this node.
@@ -79,55 +203,138 @@ class EmbeddedSerialFiller
 
     uint8_t NextPacketID() { return nextPacketId_; }
 
+    /// \brief      The frames shared by every node with this Config, whose LowWater() and Misses() show whether
+    ///             Config::FRAMES is enough.
+    static const FramePool& Frames() { return frames_; }
+
+    /// \brief      What this node has sent and received, and the errors and timeouts along the way.
+    /// \details    Takes no lock, so it can be called from any thread as often as needed without holding up traffic.
+    LinkStats Stats() const { return stats_.Read(); }
+
    private:
     /// \brief      Stores received data until a packet EOF is received, at which point the packet is
     ///             processed.
-    ByteArray rxBuffer_;
+    etl::vector<uint8_t, Config::RX_BUFFER_SIZE> rxBuffer_;
 
-    struct Subscriber
-    {
-        uint32_t id_;
-        etl::delegate<void( ByteArray& )> callback_;
-    };
+    /// \brief      Subscribers, looked up by topic for every received packet.
+    TopicTable topics_;
 
-    struct SubscriberType
-    {
-        Topic topic;
-        etl::vector<Subscriber, ESF_MAX_SUBSCRIBERS> subscribers;
-    };
-    typedef etl::vector<SubscriberType, ESF_MAX_SUBSCRIBERS> SubscriberList;
-    SubscriberList subscribers_;
+    /// \brief      Wildcard subscribers, matched against every received topic.
+    TopicTrie wildcards_;
 
     /// \brief      Stores what the next sent packet ID should be.
     uint8_t nextPacketId_;
 
-    /// \brief      Mutex that provides thread safety for the EmbeddedSerialFiller class.
-    /// \details    Only used if thread safety is enabled via SetThreadSafetyEnabled().
-    static ESF_MUTEX classMutex_;
+    typedef typename Config::Lock::Guard Guard;
+
+    /// \brief      The Config::Lock policy that provides thread safety for the EmbeddedSerialFiller class.
+    /// \details    A MutexLock is only used if thread safety is enabled via SetThreadSafetyEnabled().
+    static typename Config::Lock classLock_;
 
     bool threadSafetyEnabled_;
 
     struct AckEvent
     {
-        AckEvent() : packetId( 0 )
+        AckEvent() : packetId( 0 ), acked( false )
         {
         }
         uint8_t packetId;
-        ESF_CONDITION_VARIABLE cv;
+        bool acked;
+        typename Config::Lock::Signal signal;
     };
 
-    etl::vector<AckEvent*, ESF_MAX_PENDING_ACKS> ackEvents_;
-    AckEvent events[ ESF_MAX_PENDING_ACKS ];
+    etl::vector<AckEvent*, Config::PENDING_ACKS> ackEvents_;
+    AckEvent events[ Config::PENDING_ACKS ];
 
     int32_t maxAckPacketIndex;
 
-    /// \brief      Holds the value of the next ID that will be assigned when Subscribe() is called.
-    uint32_t nextFreeSubsriberId_;
+    /// \brief      Optional selective-repeat stream, see AttachStream().
+    ReliableStream* stream_;
+
+    /// \brief      Optional topic IDs, see AttachDictionary().
+    TopicDictionary* dictionary_;
+
+    /// \brief      Optional handler of static topics, see AttachRegistry().
+    StaticDispatch staticDispatch_;
+
+#if defined( ESF_TOPIC_PROFILER )
+    /// \brief      Optional profiling of received topics, see AttachProfiler().
+    TopicProfiler* profiler_;
+#endif
+
+    /// \brief      Optional reassembly of fragmented messages, see AttachAssembler().
+    FragmentAssembler* assembler_;
+
+    /// \brief      Stores what the ID of the next message sent by PublishLarge() should be.
+    uint8_t nextMessageId_;
+
+    /// \brief      Round trip times measured from PUBLISH to ACK.
+    RttEstimator rtt_;
+    LatencyHistogram ackLatency_;
+
+    /// \brief      Reserves one of the events a PublishWait() or PublishReliable() waits on.
+    /// \returns    nullptr if Config::PENDING_ACKS threads are already waiting.
+    AckEvent* AcquireAckEvent( uint8_t packetId );
+    void ReleaseAckEvent( uint8_t packetId );
+
+    /// \brief      Acknowledges held back by SetAckDelay().
+    AckAggregator acks_;
+
+    /// \brief      Acknowledges a received PUBLISH, either straight away or by adding it to acks_.
+    void QueueAck( uint8_t packetId );
+
+    /// \brief      Sends any held back acknowledges as an ACK_BITMAP packet.
+    void FlushAcks();
+
+    /// \brief      Completes any pending PublishWait() acknowledged by the block.
+    /// \returns    False if nothing was waiting on any of the packet IDs.
+    bool ProcessAckBlock( uint8_t base, uint16_t bitmap );
+
+    /// \brief      Extracts and handles every whole packet in the received data, for GiveRxData().
+    StatusCode ReceiveFrames( IByteArray& rxData, Guard& lock );
+
+    /// \brief      Calls every subscriber of the topic, releasing the lock around each callback.
+    void Dispatch( const Topic& topic, ByteArray& data, Guard& lock );
 
-    /// \brief      Internal publish method which does not lock the classMutex_.
-    uint8_t PublishInternal( const PacketType& packetType, uint8_t& packetId, const Topic* topic = nullptr, const ByteArray* data = nullptr );
+    /// \brief      Handles a STREAM or STREAM_ACK packet.
+    StatusCode ProcessStreamPacket( PacketType packetType, const ByteArray& decodedData, ByteArray& data, Guard& lock );
+
+    /// \brief      Passes the data of a BROADCAST/PUBLISH packet with a static topic ID to staticDispatch_.
+    StatusCode DispatchStatic( const ByteArray& decodedData, uint32_t startAt, Guard& lock );
+
+    /// \brief      Splits a BROADCAST/PUBLISH packet into topic and data, resolving any topic ID.
+    StatusCode SplitTopic( const IByteArray& decodedData, uint32_t startAt, Topic& topic, ByteArray& data );
+
+    /// \brief      Handles a FRAGMENT packet.
+    StatusCode ProcessFragment( const ByteArray& decodedData, Guard& lock );
+
+    /// \brief      Passes an encoded frame to txDataReady_, which must be set, counting it.
+    void Transmit( const ByteArray& encodedData );
+
+    /// \brief      Emits a copy of a stored frame, as the receiver is free to consume what it is given.
+    void EmitFrame( const IByteArray& frame );
+
+    /// \brief      Internal publish method which does not lock the classLock_.
+    /// \details    \p encodedTopic, from a TopicHandle, is sent in place of \p topic's length and string.
+    uint8_t PublishInternal( const PacketType& packetType, uint8_t& packetId, const Topic* topic = nullptr, const IByteArray* data = nullptr,
+                             const uint8_t* encodedTopic = nullptr );
+
+    BasicLinkCounters<typename Config::Lock::Counter> stats_;
+
+    /// \brief      Every packet buffer used by the node, kept off the stack.
+    static FramePool frames_;
 };
 
+typedef BasicEmbeddedSerialFiller<DefaultConfig> EmbeddedSerialFiller;
+
+}  // namespace esf
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller_RTOS.tpp"
+
+namespace esf
+{
+// Built once, in EmbeddedSerialFiller.cpp.
+extern template class BasicEmbeddedSerialFiller<DefaultConfig>;
 }  // namespace esf
 
 #endif  // #ifndef ESF_EMBEDDED_SERIAL_FILLER_H
@@ -0,0 +1,1086 @@
+/**
+ * \file    EmbeddedSerialFiller_RTOS.tpp
+ * \author  Julian Mitchell
+ * \date    11 Sep 2019
+ */
+
+#include "EmbeddedSerialFiller/CobsTranscoder.h"
+#include "EmbeddedSerialFiller/Utilities.h"
+
+namespace esf
+{
+template <typename Config>
+typename BasicEmbeddedSerialFiller<Config>::FramePool BasicEmbeddedSerialFiller<Config>::frames_;
+
+template <typename Config>
+typename Config::Lock BasicEmbeddedSerialFiller<Config>::classLock_;
+
+template <typename Config>
+BasicEmbeddedSerialFiller<Config>::BasicEmbeddedSerialFiller() : nextPacketId_( 1 ), threadSafetyEnabled_( true ), maxAckPacketIndex( 0 ), stream_( nullptr ), dictionary_( nullptr ), staticDispatch_( nullptr ), assembler_( nullptr ), nextMessageId_( 0 )
+{
+    classLock_.Create();
+#if defined( ESF_TOPIC_PROFILER )
+    profiler_ = nullptr;
+#endif
+}
+
+template <typename Config>
+uint8_t BasicEmbeddedSerialFiller<Config>::Publish( const Topic& topic, const ByteArray& data )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    return PublishInternal( PacketType::BROADCAST, nextPacketId_, &topic, &data );
+}
+
+template <typename Config>
+TopicHandle BasicEmbeddedSerialFiller<Config>::RegisterTopic( const Topic& topic )
+{
+    return TopicHandle( topic, TopicTable::Hash( topic ) );
+}
+
+template <typename Config>
+uint8_t BasicEmbeddedSerialFiller<Config>::Publish( const TopicHandle& topic, const ByteArray& data )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    return PublishInternal( PacketType::BROADCAST, nextPacketId_, &topic.topic_, &data, topic.encoded_ );
+}
+
+template <typename Config>
+PublishResponse BasicEmbeddedSerialFiller<Config>::PublishWait( const Topic& topic, const ByteArray& data, size_t timeout )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    bool gotAck = false;
+    // Take a copy since PublishInternal updates the value of nextPacketId_.
+    auto packetId = nextPacketId_;
+    AckEvent* ackEvent = AcquireAckEvent( packetId );
+    if( ackEvent != nullptr )
+    {
+        // Call the standard publish
+        uint32_t sentAt = ESF_CLOCK_MS();
+        if( PublishInternal( PacketType::PUBLISH, nextPacketId_, &topic, &data ) == 0 )
+        {
+            // Nothing was sent (the pool miss is counted), so there's no ACK to wait for.
+            ReleaseAckEvent( packetId );
+            return PublishResponse::NOT_SENT;
+        }
+        gotAck = lock.Wait( ackEvent->signal, ackEvent->acked, timeout );
+        if( gotAck )
+        {
+            uint32_t rtt = ESF_CLOCK_MS() - sentAt;
+            rtt_.AddSample( rtt );
+            ackLatency_.Add( rtt );
+        }
+        else
+        {
+            stats_.AckTimeout();
+        }
+        ReleaseAckEvent( packetId );
+    }
+    return gotAck ? PublishResponse::SUCCESS : PublishResponse::TIMEOUT;
+}
+
+template <typename Config>
+PublishResponse BasicEmbeddedSerialFiller<Config>::PublishReliable( const Topic& topic, const ByteArray& data, uint8_t maxRetransmits )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    bool gotAck = false;
+    // Take a copy since PublishInternal updates the value of nextPacketId_.
+    auto packetId = nextPacketId_;
+    AckEvent* ackEvent = AcquireAckEvent( packetId );
+    if( ackEvent != nullptr )
+    {
+        uint32_t rto = rtt_.Rto();
+        uint32_t sentAt = ESF_CLOCK_MS();
+        if( PublishInternal( PacketType::PUBLISH, nextPacketId_, &topic, &data ) == 0 )
+        {
+            // Nothing was sent (the pool miss is counted), so there's no ACK to wait for.
+            ReleaseAckEvent( packetId );
+            return PublishResponse::NOT_SENT;
+        }
+        for( uint8_t retransmits = 0;; ++retransmits )
+        {
+            // Keep waiting out the full timeout if woken without the ACK having arrived.
+            uint32_t waited = ESF_CLOCK_MS() - sentAt;
+            while( !ackEvent->acked && ( waited < rto ) )
+            {
+                lock.Wait( ackEvent->signal, ackEvent->acked, rto - waited );
+                waited = ESF_CLOCK_MS() - sentAt;
+            }
+            if( ackEvent->acked )
+            {
+                // Karn's algorithm, the round trip time is ambiguous once the packet has been resent.
+                if( retransmits == 0 )
+                {
+                    rtt_.AddSample( waited );
+                    ackLatency_.Add( waited );
+                }
+                gotAck = true;
+                break;
+            }
+            if( retransmits == maxRetransmits )
+            {
+                stats_.AckTimeout();
+                break;
+            }
+
+            // Resend with the same packet ID, so a late ACK of an earlier copy still counts.
+            stats_.Retransmit();
+            rto = rtt_.Backoff( rto );
+            sentAt = ESF_CLOCK_MS();
+            uint8_t resendId = packetId;
+            PublishInternal( PacketType::PUBLISH, resendId, &topic, &data );
+        }
+        ReleaseAckEvent( packetId );
+    }
+    return gotAck ? PublishResponse::SUCCESS : PublishResponse::TIMEOUT;
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::SetRetransmissionTimeouts( uint32_t initialRto, uint32_t minRto, uint32_t maxRto )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    rtt_.Reset( initialRto, minRto, maxRto );
+}
+
+template <typename Config>
+RttEstimator BasicEmbeddedSerialFiller<Config>::RoundTripTime()
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    return rtt_;
+}
+
+template <typename Config>
+typename BasicEmbeddedSerialFiller<Config>::LatencyHistogram BasicEmbeddedSerialFiller<Config>::AckLatency()
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    return ackLatency_;
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::ResetAckLatency()
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    ackLatency_.Reset();
+}
+
+template <typename Config>
+typename BasicEmbeddedSerialFiller<Config>::AckEvent* BasicEmbeddedSerialFiller<Config>::AcquireAckEvent( uint8_t packetId )
+{
+    if( ackEvents_.full() == false )
+    {
+        // Find first free ackEvent
+        uint8_t eventIndex;
+        for( eventIndex = 0; eventIndex < Config::PENDING_ACKS; ++eventIndex )
+        {
+            if( events[ eventIndex ].packetId == 0 )
+            {
+                if( eventIndex > maxAckPacketIndex )
+                {
+                    maxAckPacketIndex = eventIndex;
+                }
+                break;
+            }
+        }
+        if( eventIndex < Config::PENDING_ACKS )
+        {
+            AckEvent& ackEvent = events[ eventIndex ];
+            ackEvent.packetId = packetId;
+            ackEvent.acked = false;
+            ackEvents_.push_back( &ackEvent );
+            return &ackEvent;
+        }
+        else
+        {
+            printf( "!!!  Invalid index !!!\r\n" );
+        }
+    }
+    else
+    {
+        printf( "!!!  Run out of AckEvents !!!\r\n" );
+    }
+    return nullptr;
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::ReleaseAckEvent( uint8_t packetId )
+{
+    for( auto it = ackEvents_.begin(); it != ackEvents_.end(); ++it )
+    {
+        if( ( *it )->packetId == packetId )
+        {
+            // Remove event
+            // Allow this event to be reused.
+            ( *it )->packetId = 0;
+            *it = 0;
+            ackEvents_.erase( it );
+            break;
+        }
+    }
+}
+
+template <typename Config>
+uint32_t BasicEmbeddedSerialFiller<Config>::Subscribe( const Topic& topic, etl::delegate<void( ByteArray& )> callback )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    if( TopicTrie::IsPattern( topic ) )
+    {
+        return wildcards_.Add( topic, callback );
+    }
+    return topics_.Add( topic, callback );
+}
+
+template <typename Config>
+uint32_t BasicEmbeddedSerialFiller<Config>::Subscribe( const TopicHandle& topic, etl::delegate<void( ByteArray& )> callback )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    if( TopicTrie::IsPattern( topic.topic_ ) )
+    {
+        return wildcards_.Add( topic.topic_, callback );
+    }
+    return topics_.Add( topic.topic_, topic.hash_, callback );
+}
+
+template <typename Config>
+StatusCode BasicEmbeddedSerialFiller<Config>::Unsubscribe( uint32_t subscriberId )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    return ( topics_.Remove( subscriberId ) || wildcards_.Remove( subscriberId ) ) ? StatusCode::SUCCESS : StatusCode::ERROR_UNRECOGNISED_SUBSCRIBER;
+}
+
+template <typename Config>
+StatusCode BasicEmbeddedSerialFiller<Config>::Unsubscribe( const TopicHandle& topic )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    if( TopicTrie::IsPattern( topic.topic_ ) )
+    {
+        return wildcards_.RemovePattern( topic.topic_ ) ? StatusCode::SUCCESS : StatusCode::ERROR_UNRECOGNISED_SUBSCRIBER;
+    }
+    return topics_.RemoveTopic( topic.topic_, topic.hash_ ) ? StatusCode::SUCCESS : StatusCode::ERROR_UNRECOGNISED_SUBSCRIBER;
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::UnsubscribeAll()
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    topics_.Clear();
+    wildcards_.Clear();
+}
+
+template <typename Config>
+StatusCode BasicEmbeddedSerialFiller<Config>::GiveRxData( IByteArray& rxData )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    size_t bytes = rxData.size();
+    StatusCode result = ReceiveFrames( rxData, lock );
+    stats_.Received( bytes, result, rxBuffer_.size() );
+    return result;
+}
+
+template <typename Config>
+StatusCode BasicEmbeddedSerialFiller<Config>::ReceiveFrames( IByteArray& rxData, Guard& lock )
+{
+    StatusCode result = StatusCode::SUCCESS;
+    typename FramePool::Handle packetFrame( frames_ );
+    typename FramePool::Handle decodedFrame( frames_ );
+    if( !packetFrame || !decodedFrame )
+    {
+        return StatusCode::ERROR_NO_FREE_FRAMES;
+    }
+    // A packet that was received whole but couldn't be used, returned if nothing worse happens.
+    StatusCode rejected = StatusCode::SUCCESS;
+    ByteArray& packet = *packetFrame;
+    result = Utilities::MoveRxDataInBuffer( rxData, rxBuffer_, packet );
+    if( result == StatusCode::SUCCESS )
+    {
+        while( !packet.empty() )
+        {
+            stats_.Frame( packet.size() );
+            ESF_TRACE( frame, this, packet.size(), rxBuffer_.size() );
+            Topic topic;
+
+            //==============================//
+            //======= FOR EACH PACKET ======//
+            //==============================//
+
+            // Remove COBS encoding
+            ByteArray& decodedData = *decodedFrame;
+            result = CobsTranscoder::Decode( packet, decodedData );
+            ESF_TRACE( decoded, this, decodedData.size(), static_cast<int>( result ) );
+            if( result == StatusCode::SUCCESS )
+            {
+                // Verify CRC
+                result = Utilities::VerifyCrc( decodedData );
+                ESF_TRACE( crc, this, decodedData.size(), static_cast<int>( result ) );
+                if( result == StatusCode::SUCCESS )
+                {
+                    // Look at packet type
+                    auto packetType = static_cast<PacketType>( decodedData[ 0 ] );
+                    // Extract packet ID
+                    uint8_t packetId = static_cast<uint8_t>( decodedData.at( 1 ) );
+                    if( ( packetType == PacketType::BROADCAST ) || ( packetType == PacketType::PUBLISH ) ||
+                        ( packetType == PacketType::BROADCAST_ACKS ) || ( packetType == PacketType::PUBLISH_ACKS ) )
+                    {
+                        uint32_t startAt = 2;
+                        if( ( packetType == PacketType::BROADCAST_ACKS ) || ( packetType == PacketType::PUBLISH_ACKS ) )
+                        {
+                            // Acknowledges riding along with the data.
+                            if( decodedData.size() < ( startAt + AckAggregator::BLOCK_SIZE + 3 ) )
+                            {
+                                result = StatusCode::ERROR_NOT_ENOUGH_BYTES;
+                            }
+                            else
+                            {
+                                ProcessAckBlock( decodedData[ startAt ], static_cast<uint16_t>( ( decodedData[ startAt + 1 ] << 8 ) | decodedData[ startAt + 2 ] ) );
+                                startAt += AckAggregator::BLOCK_SIZE;
+                            }
+                        }
+
+                        if( result != StatusCode::SUCCESS )
+                        {
+                            // Too short to hold its acknowledges, let alone a topic.
+                        }
+                        else if( ( decodedData[ startAt ] & ESF_STATIC_TOPIC_FLAG ) == ESF_STATIC_TOPIC_FLAG )
+                        {
+                            result = DispatchStatic( decodedData, startAt, lock );
+                            if( result == StatusCode::SUCCESS )
+                            {
+                                if( ( packetType == PacketType::PUBLISH ) || ( packetType == PacketType::PUBLISH_ACKS ) )
+                                {
+                                    QueueAck( packetId );
+                                }
+                            }
+                        }
+                        else
+                        {
+                            // 4. Then split packet into topic and data (let's just reuse the packet container for this);
+                            ByteArray& data = packet;
+                            result = SplitTopic( decodedData, startAt, topic, data );
+                            if( result == StatusCode::SUCCESS )
+                            {
+                                // WARNING: Make sure to send ack BEFORE invoking topic callbacks, as they may cause other messages
+                                // to be sent, and we always want the ACK to be the first thing sent back to the sender.
+                                if( ( packetType == PacketType::PUBLISH ) || ( packetType == PacketType::PUBLISH_ACKS ) )
+                                {
+                                    QueueAck( packetId );
+                                }
+
+                                // 5. Call every callback associated with this topic
+                                Dispatch( topic, data, lock );
+                            }
+                        }
+                    }
+                    else if( packetType == PacketType::ACK )
+                    {
+                        auto it = ackEvents_.begin();
+                        for( ; it != ackEvents_.end(); ++it )
+                        {
+                            if( ( *it )->packetId == packetId )
+                            {
+                                break;
+                            }
+                        }
+                        if( it == ackEvents_.end() )
+                        {
+                            result = StatusCode::ERROR_UNEXPECTED_ACK;
+                        }
+                        else
+                        {
+                            ESF_TRACE( ack_matched, this, packetId, 0 );
+                            ( *it )->acked = true;
+                            ( *it )->signal.notify_all();
+                        }
+                    }
+                    else if( packetType == PacketType::ACK_BITMAP )
+                    {
+                        if( decodedData.size() < ( 1 + AckAggregator::BLOCK_SIZE + 2 ) )
+                        {
+                            result = StatusCode::ERROR_NOT_ENOUGH_BYTES;
+                        }
+                        else if( !ProcessAckBlock( packetId, static_cast<uint16_t>( ( decodedData[ 2 ] << 8 ) | decodedData[ 3 ] ) ) )
+                        {
+                            result = StatusCode::ERROR_UNEXPECTED_ACK;
+                        }
+                    }
+                    else if( ( packetType == PacketType::STREAM ) || ( packetType == PacketType::STREAM_ACK ) )
+                    {
+                        result = ProcessStreamPacket( packetType, decodedData, packet, lock );
+                    }
+                    else if( packetType == PacketType::TOPIC_ANNOUNCE )
+                    {
+                        // Ignored without a dictionary, as by a node without topic IDs, so the remote node keeps to topic strings.
+                        if( dictionary_ != nullptr )
+                        {
+                            result = Utilities::SplitPacket( decodedData, 2, topic, packet );
+                            if( result == StatusCode::SUCCESS )
+                            {
+                                // An ID beyond this node's dictionary is rejected, so the remote node keeps to the string.
+                                uint8_t ackId = dictionary_->RxLearn( packetId, topic ) ? packetId : static_cast<uint8_t>( TopicDictionary::TOPIC_ID_FLAG | packetId );
+                                PublishInternal( PacketType::TOPIC_ACK, ackId );
+                            }
+                        }
+                    }
+                    else if( packetType == PacketType::TOPIC_ACK )
+                    {
+                        if( dictionary_ != nullptr )
+                        {
+                            if( packetId & TopicDictionary::TOPIC_ID_FLAG )
+                            {
+                                dictionary_->TxReject( packetId & ~TopicDictionary::TOPIC_ID_FLAG );
+                            }
+                            else
+                            {
+                                dictionary_->TxConfirm( packetId );
+                            }
+                        }
+                    }
+                    else if( packetType == PacketType::FRAGMENT )
+                    {
+                        result = ProcessFragment( decodedData, lock );
+                    }
+                    else
+                    {
+                        result = StatusCode::ERROR_UNRECOGNISED_PACKET_TYPE;
+                    }
+
+                    if( result != StatusCode::SUCCESS )
+                    {
+                        // Only this packet is lost, the frames after it are still processed.
+                        rejected = result;
+                        result = StatusCode::SUCCESS;
+                    }
+
+                    // If there's more data to process then do so.
+                    if( rxData.size() )
+                    {
+                        result = Utilities::MoveRxDataInBuffer( rxData, rxBuffer_, packet );
+                    }
+                    else
+                    {
+                        packet.clear();
+                    }
+                    if( result == StatusCode::SUCCESS )
+                    {
+                        // All good.
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+                else
+                {
+                    break;
+                }
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+    return ( result != StatusCode::SUCCESS ) ? result : rejected;
+}
+
+template <typename Config>
+uint32_t BasicEmbeddedSerialFiller<Config>::NumThreadsWaiting()
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    return static_cast<uint32_t>( ackEvents_.size() );
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::AttachStream( ReliableStream* stream )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    stream_ = stream;
+}
+
+template <typename Config>
+StatusCode BasicEmbeddedSerialFiller<Config>::PublishStream( const Topic& topic, const ByteArray& data )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    if( stream_ == nullptr )
+    {
+        return StatusCode::ERROR_STREAM_NOT_ATTACHED;
+    }
+
+    ByteArray* frame;
+    {
+        // Built in a frame from the pool, then encoded into the stream's copy to be resent from.
+        typename FramePool::Handle packetFrame( frames_ );
+        if( !packetFrame )
+        {
+            stats_.Error( StatusCode::ERROR_NO_FREE_FRAMES );
+            return StatusCode::ERROR_NO_FREE_FRAMES;
+        }
+        uint16_t sequence;
+        frame = stream_->TxAllocate( sequence );
+        if( frame == nullptr )
+        {
+            return StatusCode::ERROR_STREAM_WINDOW_FULL;
+        }
+        ReliableStream::EncodeFrame( PacketType::STREAM, sequence, &topic, &data, *packetFrame, *frame );
+    }
+    EmitFrame( *frame );
+    return StatusCode::SUCCESS;
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::AttachDictionary( TopicDictionary* dictionary )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    dictionary_ = dictionary;
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::AttachRegistry( StaticDispatch dispatch )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    staticDispatch_ = dispatch;
+}
+
+#if defined( ESF_TOPIC_PROFILER )
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::AttachProfiler( TopicProfiler* profiler )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    profiler_ = profiler;
+}
+#endif
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::AttachAssembler( FragmentAssembler* assembler )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    assembler_ = assembler;
+}
+
+template <typename Config>
+StatusCode BasicEmbeddedSerialFiller<Config>::PublishLarge( const Topic& topic, const uint8_t* data, size_t size )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    if( FRAGMENT_SIZE == 0 )
+    {
+        return StatusCode::ERROR_MESSAGE_TOO_LARGE;
+    }
+    size_t count = FragmentAssembler::FragmentCount( size, FRAGMENT_SIZE );
+    if( count > 0xFFFF )
+    {
+        return StatusCode::ERROR_MESSAGE_TOO_LARGE;
+    }
+
+    typename FramePool::Handle packetFrame( frames_ );
+    typename FramePool::Handle encodedFrame( frames_ );
+    if( !packetFrame || !encodedFrame )
+    {
+        stats_.Error( StatusCode::ERROR_NO_FREE_FRAMES );
+        return StatusCode::ERROR_NO_FREE_FRAMES;
+    }
+    ByteArray& encodedData = *encodedFrame;
+    uint8_t messageId = nextMessageId_++;
+    for( size_t index = 0; index < count; ++index )
+    {
+        FragmentAssembler::EncodeFragment( messageId, static_cast<uint16_t>( index ), static_cast<uint16_t>( count ), topic, data, size, FRAGMENT_SIZE, *packetFrame, encodedData );
+        if( txDataReady_ )
+        {
+            Transmit( encodedData );
+        }
+    }
+    return StatusCode::SUCCESS;
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::Poll( uint32_t elapsed )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    if( acks_.Tick( elapsed ) )
+    {
+        FlushAcks();
+    }
+
+    if( stream_ != nullptr )
+    {
+        stream_->Tick( elapsed );
+
+        // Selective repeat, only the frames whose timers have expired are resent.
+        const ByteArray* frame;
+        while( ( frame = stream_->TxNextRetransmit() ) != nullptr )
+        {
+            stats_.Retransmit();
+            EmitFrame( *frame );
+        }
+    }
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::SetAckDelay( uint32_t delay )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    acks_.SetDelay( delay );
+    if( delay == 0 )
+    {
+        FlushAcks();
+    }
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::QueueAck( uint8_t packetId )
+{
+    if( acks_.Delay() == 0 )
+    {
+        ESF_TRACE( ack_sent, this, packetId, 0 );
+        PublishInternal( PacketType::ACK, packetId );
+    }
+    else if( !acks_.Add( packetId ) )
+    {
+        // Too far from the pending block's base, send that first.
+        FlushAcks();
+        acks_.Add( packetId );
+    }
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::FlushAcks()
+{
+    if( acks_.Pending() )
+    {
+        uint8_t base;
+        uint16_t bitmap;
+        acks_.Take( base, bitmap );
+        etl::vector<uint8_t, AckAggregator::BLOCK_SIZE - 1> block( { static_cast<uint8_t>( ( bitmap >> 8 ) & 0xFF ), static_cast<uint8_t>( ( bitmap >> 0 ) & 0xFF ) } );
+        ESF_TRACE( ack_sent, this, base, bitmap );
+        PublishInternal( PacketType::ACK_BITMAP, base, nullptr, &block );
+    }
+}
+
+template <typename Config>
+bool BasicEmbeddedSerialFiller<Config>::ProcessAckBlock( uint8_t base, uint16_t bitmap )
+{
+    bool matched = false;
+    for( auto it = ackEvents_.begin(); it != ackEvents_.end(); ++it )
+    {
+        if( AckAggregator::Contains( base, bitmap, ( *it )->packetId ) )
+        {
+            ESF_TRACE( ack_matched, this, ( *it )->packetId, 0 );
+            ( *it )->acked = true;
+            ( *it )->signal.notify_all();
+            matched = true;
+        }
+    }
+    return matched;
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::Dispatch( const Topic& topic, ByteArray& data, Guard& lock )
+{
+    const typename TopicTable::SubscriberList* matches[ ESF_MAX_WILDCARDS ];
+    const size_t numMatches = wildcards_.Match( topic, matches );
+    const typename TopicTable::SubscriberList* subscribers = topics_.Find( topic );
+    if( ( subscribers == nullptr ) && ( numMatches == 0 ) )
+    {
+#if defined( ESF_TOPIC_PROFILER )
+        if( profiler_ != nullptr )
+        {
+            profiler_->Message( topic, data.size(), ESF_PROFILER_CLOCK() );
+        }
+#endif
+        // If no subscribers are listening to this topic,
+        // notify clients using the "no subscribers for topic" callback.
+        if( noSubscribersForTopic_ )
+        {
+            lock.unlock();
+            noSubscribersForTopic_( topic, data );
+            lock.lock();
+        }
+        return;
+    }
+
+#if defined( ESF_TOPIC_PROFILER )
+    TopicProfiler::Profile* profile = ( profiler_ != nullptr ) ? profiler_->Message( topic, data.size(), ESF_PROFILER_CLOCK() ) : nullptr;
+#endif
+    // The topic's own subscribers, then those of each matching wildcard.
+    for( size_t i = 0; i <= numMatches; ++i )
+    {
+        const typename TopicTable::SubscriberList* list = ( i == 0 ) ? subscribers : matches[ i - 1 ];
+        if( list == nullptr )
+        {
+            continue;
+        }
+        for( auto subIter = list->begin(); subIter != list->end(); ++subIter )
+        {
+            lock.unlock();
+            ESF_TRACE( callback_entry, this, topic.c_str(), data.size() );
+#if defined( ESF_TOPIC_PROFILER )
+            uint32_t start = ( profile != nullptr ) ? ESF_PROFILER_CLOCK() : 0;
+            subIter->callback_( data );
+            uint32_t ticks = ( profile != nullptr ) ? ESF_PROFILER_CLOCK() - start : 0;
+#else
+            subIter->callback_( data );
+#endif
+            ESF_TRACE( callback_exit, this, topic.c_str(), data.size() );
+            lock.lock();
+#if defined( ESF_TOPIC_PROFILER )
+            if( profile != nullptr )
+            {
+                profiler_->Callback( *profile, ticks );
+            }
+#endif
+        }
+    }
+}
+
+template <typename Config>
+StatusCode BasicEmbeddedSerialFiller<Config>::ProcessStreamPacket( PacketType packetType, const ByteArray& decodedData, ByteArray& data, Guard& lock )
+{
+    if( stream_ == nullptr )
+    {
+        return StatusCode::ERROR_STREAM_NOT_ATTACHED;
+    }
+    // Type, 2 byte sequence, CRC and for a STREAM packet at least the topic length.
+    if( decodedData.size() < ( packetType == PacketType::STREAM ? 6u : 5u ) )
+    {
+        return StatusCode::ERROR_NOT_ENOUGH_BYTES;
+    }
+    uint16_t sequence = static_cast<uint16_t>( ( decodedData[ 1 ] << 8 ) | decodedData[ 2 ] );
+
+    if( packetType == PacketType::STREAM_ACK )
+    {
+        stream_->TxAcknowledge( sequence );
+        return StatusCode::SUCCESS;
+    }
+
+    if( stream_->RxAccept( sequence, decodedData ) != ReliableStream::RxVerdict::OUT_OF_WINDOW )
+    {
+        // As with PUBLISH, acknowledge before any callbacks get the chance to send something else.
+        typename FramePool::Handle encodedFrame( frames_ );
+        if( !encodedFrame )
+        {
+            stats_.Error( StatusCode::ERROR_NO_FREE_FRAMES );
+        }
+        else if( txDataReady_ )
+        {
+            // Type, sequence number and CRC.
+            etl::vector<uint8_t, 5> ackPacket;
+            ReliableStream::EncodeFrame( PacketType::STREAM_ACK, sequence, nullptr, nullptr, ackPacket, *encodedFrame );
+            Transmit( *encodedFrame );
+        }
+    }
+
+    // Deliver everything that is now contiguous with the last frame delivered.
+    StatusCode result = StatusCode::SUCCESS;
+    const ByteArray* next;
+    while( ( next = stream_->RxNextInOrder() ) != nullptr )
+    {
+        Topic topic;
+        result = Utilities::SplitPacket( *next, 3, topic, data );
+        stream_->RxRelease();
+        if( result == StatusCode::SUCCESS )
+        {
+            Dispatch( topic, data, lock );
+        }
+    }
+    return result;
+}
+
+template <typename Config>
+StatusCode BasicEmbeddedSerialFiller<Config>::ProcessFragment( const ByteArray& decodedData, Guard& lock )
+{
+    if( assembler_ == nullptr )
+    {
+        return StatusCode::ERROR_ASSEMBLER_NOT_ATTACHED;
+    }
+    if( assembler_->Accept( decodedData ) == FragmentAssembler::Progress::COMPLETE )
+    {
+        if( assembler_->messageReceived_ )
+        {
+            lock.unlock();
+            assembler_->messageReceived_( assembler_->MessageTopic(), assembler_->MessageData(), assembler_->MessageSize() );
+            lock.lock();
+        }
+    }
+    return StatusCode::SUCCESS;
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::Transmit( const ByteArray& encodedData )
+{
+    stats_.Sent( encodedData.size() );
+    ESF_TRACE( tx, this, encodedData.data(), encodedData.size() );
+    txDataReady_( encodedData );
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::EmitFrame( const IByteArray& frame )
+{
+    typename FramePool::Handle encodedFrame( frames_ );
+    if( !encodedFrame )
+    {
+        stats_.Error( StatusCode::ERROR_NO_FREE_FRAMES );
+    }
+    else if( txDataReady_ )
+    {
+        encodedFrame->assign( frame.begin(), frame.end() );
+        Transmit( *encodedFrame );
+    }
+}
+
+template <typename Config>
+StatusCode BasicEmbeddedSerialFiller<Config>::DispatchStatic( const ByteArray& decodedData, uint32_t startAt, Guard& lock )
+{
+    // The topic ID and CRC at least, anything shorter would leave the payload size negative.
+    if( decodedData.size() < ( startAt + 3 ) )
+    {
+        return StatusCode::ERROR_NOT_ENOUGH_BYTES;
+    }
+    uint8_t topicId = decodedData[ startAt ] & ~ESF_STATIC_TOPIC_FLAG;
+    const uint8_t* data = decodedData.data() + startAt + 1;
+    size_t size = decodedData.size() - startAt - 1 - 2;
+    bool handled = false;
+    if( staticDispatch_ != nullptr )
+    {
+        lock.unlock();
+        ESF_TRACE( static_callback_entry, this, topicId, size );
+        handled = staticDispatch_( topicId, data, size );
+        ESF_TRACE( static_callback_exit, this, topicId, size );
+        lock.lock();
+    }
+    return handled ? StatusCode::SUCCESS : StatusCode::ERROR_UNKNOWN_TOPIC_ID;
+}
+
+template <typename Config>
+StatusCode BasicEmbeddedSerialFiller<Config>::SplitTopic( const IByteArray& decodedData, uint32_t startAt, Topic& topic, ByteArray& data )
+{
+    uint8_t lengthOfTopic = decodedData[ startAt ];
+    if( ( lengthOfTopic & TopicDictionary::TOPIC_ID_FLAG ) == 0 )
+    {
+        return Utilities::SplitPacket( decodedData, startAt, topic, data );
+    }
+
+    const Topic* known = ( dictionary_ != nullptr ) ? dictionary_->RxResolve( lengthOfTopic & ~TopicDictionary::TOPIC_ID_FLAG ) : nullptr;
+    if( known == nullptr )
+    {
+        // Ask the sender to announce it again.
+        PublishInternal( PacketType::TOPIC_ACK, lengthOfTopic );
+        return StatusCode::ERROR_UNKNOWN_TOPIC_ID;
+    }
+    topic = *known;
+    data.assign( decodedData.begin() + startAt + 1, decodedData.end() - 2 );
+    return StatusCode::SUCCESS;
+}
+
+template <typename Config>
+uint8_t BasicEmbeddedSerialFiller<Config>::PublishInternal( const PacketType& packetType, uint8_t& packetId, const Topic* topic /* = nullptr*/, const IByteArray* data /* = nullptr*/,
+                                                            const uint8_t* encodedTopic /* = nullptr*/ )
+{
+    uint8_t retVal = packetId;
+
+    // Announce the topic the first time it is used, before taking the frames.
+    uint8_t topicId = 0;
+    bool sendTopicId = false;
+    if( ( dictionary_ != nullptr ) && ( topic != nullptr ) && ( ( packetType == PacketType::BROADCAST ) || ( packetType == PacketType::PUBLISH ) ) )
+    {
+        TopicDictionary::TxAction action = dictionary_->TxLookup( *topic, topicId );
+        if( action == TopicDictionary::TxAction::ANNOUNCE )
+        {
+            PublishInternal( PacketType::TOPIC_ANNOUNCE, topicId, topic );
+        }
+        sendTopicId = ( action == TopicDictionary::TxAction::SEND_ID );
+    }
+
+    typename FramePool::Handle packetFrame( frames_ );
+    typename FramePool::Handle encodedFrame( frames_ );
+    if( !packetFrame || !encodedFrame )
+    {
+        stats_.Error( StatusCode::ERROR_NO_FREE_FRAMES );
+        return 0;
+    }
+    ByteArray& txPacket = *packetFrame;
+
+    // Let any held back acknowledges ride along with the data.
+    bool withAcks = acks_.Pending() && txDataReady_ && ( ( packetType == PacketType::BROADCAST ) || ( packetType == PacketType::PUBLISH ) );
+
+    // 1st byte is the packet type, in this case it's PUBLISH
+    if( withAcks )
+    {
+        txPacket.emplace_back( static_cast<uint8_t>( packetType == PacketType::BROADCAST ? PacketType::BROADCAST_ACKS : PacketType::PUBLISH_ACKS ) );
+    }
+    else
+    {
+        txPacket.emplace_back( static_cast<uint8_t>( packetType ) );
+    }
+
+    // 2nd byte is the packet identifier
+    txPacket.emplace_back( packetId );
+
+    if( withAcks )
+    {
+        uint8_t base;
+        uint16_t bitmap;
+        acks_.Take( base, bitmap );
+        txPacket.emplace_back( base );
+        txPacket.emplace_back( static_cast<uint8_t>( ( bitmap >> 8 ) & 0xFF ) );
+        txPacket.emplace_back( static_cast<uint8_t>( ( bitmap >> 0 ) & 0xFF ) );
+    }
+    switch( packetType )
+    {
+        case PacketType::BROADCAST:
+        case PacketType::PUBLISH:
+        {
+            if( sendTopicId )
+            {
+                // The topic ID replaces the topic length and string.
+                txPacket.emplace_back( static_cast<uint8_t>( TopicDictionary::TOPIC_ID_FLAG | topicId ) );
+            }
+            else if( encodedTopic != nullptr )
+            {
+                // The length and string, laid out by RegisterTopic().
+                txPacket.insert( txPacket.end(), encodedTopic, encodedTopic + 1 + encodedTopic[ 0 ] );
+            }
+            else if( topic != nullptr )
+            {
+                // 3rd byte (pre-COBS encoded) is num. of bytes for topic
+                txPacket.emplace_back( static_cast<uint8_t>( topic->size() ) );
+#if defined( ESF_OPTIMISE )
+                Topic::const_iterator iter = topic->begin();
+                Topic::const_iterator endIter = topic->end();
+                for( ; iter < endIter; ++iter )
+                {
+                    txPacket.emplace_back( *iter );
+                }
+#else
+                txPacket.insert( txPacket.end(), topic->begin(), topic->end() );
+#endif
+            }
+            if( data != nullptr )
+            {
+#if defined( ESF_OPTIMISE )
+                assert( data->size() <= Config::PACKET_SIZE );
+                txPacket.insert( txPacket.end(), data->begin(), data->end() );
+#else
+                IByteArray::const_iterator iter = data->begin();
+                IByteArray::const_iterator endIter = data->end();
+                for( ; iter < endIter; ++iter )
+                {
+                    txPacket.emplace_back( *iter );
+                }
+#endif
+            }
+        }
+        break;
+        case PacketType::ACK:
+        case PacketType::TOPIC_ACK:
+            break;
+        case PacketType::TOPIC_ANNOUNCE:
+            txPacket.emplace_back( static_cast<uint8_t>( topic->size() ) );
+            txPacket.insert( txPacket.end(), topic->begin(), topic->end() );
+            break;
+        case PacketType::ACK_BITMAP:
+            // The data is the bitmap.
+            if( data != nullptr )
+            {
+                txPacket.insert( txPacket.end(), data->begin(), data->end() );
+            }
+            break;
+        default:
+            printf( "!!!  Unrecognised packet type !!!\r\n" );
+            break;
+    }
+
+    // Add CRC
+    Utilities::AddCrc( txPacket );
+
+    // Encode data using COBS, freeing the packet's frame for anything sent from within txDataReady_.
+    ByteArray& encodedData = *encodedFrame;
+    CobsTranscoder::Encode( txPacket, encodedData );
+    packetFrame.Release();
+
+    // Emit TX send event
+    if( txDataReady_ )
+    {
+        Transmit( encodedData );
+    }
+    else
+    {
+        return retVal;
+    }
+
+    if( ( packetType == PacketType::BROADCAST ) || ( packetType == PacketType::PUBLISH ) )
+    {
+        // If everything was successful, increment packet ID
+        ++packetId;
+        if( packetId == 0 )
+        {
+            // ID == 0 is invalid.
+            ++packetId;
+        }
+    }
+    return retVal;
+}
+
+template <typename Config>
+uint8_t BasicEmbeddedSerialFiller<Config>::PublishStatic( uint8_t topicId, const uint8_t* data, size_t size )
+{
+    Guard lock( classLock_, threadSafetyEnabled_ );
+
+    uint8_t retVal = nextPacketId_;
+    typename FramePool::Handle packetFrame( frames_ );
+    typename FramePool::Handle encodedFrame( frames_ );
+    if( !packetFrame || !encodedFrame )
+    {
+        stats_.Error( StatusCode::ERROR_NO_FREE_FRAMES );
+        return 0;
+    }
+    ByteArray& txPacket = *packetFrame;
+    txPacket.emplace_back( static_cast<uint8_t>( PacketType::BROADCAST ) );
+    txPacket.emplace_back( nextPacketId_ );
+    // The static topic ID replaces the topic length and string.
+    txPacket.emplace_back( static_cast<uint8_t>( ESF_STATIC_TOPIC_FLAG | topicId ) );
+    txPacket.insert( txPacket.end(), data, data + size );
+    Utilities::AddCrc( txPacket );
+
+    ByteArray& encodedData = *encodedFrame;
+    CobsTranscoder::Encode( txPacket, encodedData );
+    packetFrame.Release();
+    if( txDataReady_ )
+    {
+        Transmit( encodedData );
+        ++nextPacketId_;
+        if( nextPacketId_ == 0 )
+        {
+            // ID == 0 is invalid.
+            ++nextPacketId_;
+        }
+    }
+    return retVal;
+}
+
+template <typename Config>
+void BasicEmbeddedSerialFiller<Config>::SetThreadSafetyEnabled( bool value )
+{
+    threadSafetyEnabled_ = value;
+}
+
+}  // namespace esf
@@ -0,0 +1,101 @@
+/**
+ * \file    FragmentAssembler.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_FRAGMENT_ASSEMBLER_H
+#define ESF_FRAGMENT_ASSEMBLER_H
+
+#include <etl/delegate.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "EmbeddedSerialFiller/Definitions.h"
+
+namespace esf
+{
+/// \brief Reassembles the fragments sent by EmbeddedSerialFiller::PublishLarge() into a caller-provided buffer.
+/// \details
+/// Messages larger than a single packet are split into fragments of up to ESF_FRAGMENT_SIZE bytes (fewer if the
+/// sender's packets are too small for that, see FragmentSize()), which are sent back to back. Fragments are not acknowledged; if one is lost (or a message doesn't fit the buffer) the whole
+/// message is discarded. Only one message is reassembled at a time.
+///
+/// Fragment packet structure:
+/// [ 0x46, <message ID>, <index MSB>, <index LSB>, <count MSB>, <count LSB>, <length of topic id>, <topic ID 1>, ..., <data n>, <CRC MSB>, <CRC LSB> ]
+class FragmentAssembler
+{
+   public:
+    /// \brief What Accept() did with a fragment.
+    enum class Progress : uint8_t
+    {
+        INCOMPLETE,  // Stored, more fragments to come.
+        COMPLETE,    // That was the last fragment, the message can be read back.
+        DISCARDED,   // Out of sequence, malformed or too large for the buffer.
+    };
+
+    /// \brief Fragment header size, from the packet type up to and including the topic length.
+    static const size_t HEADER_SIZE = 7;
+
+    /// \param  buffer      Where messages are reassembled, owned by the caller.
+    /// \param  capacity    Size of \p buffer, the largest message that can be received.
+    FragmentAssembler( uint8_t* buffer, size_t capacity );
+
+    /// \brief      Discards any partially received message.
+    void Reset();
+
+    /// \brief      Offers a received (COBS decoded, CRC verified) FRAGMENT packet.
+    Progress Accept( const IByteArray& decodedPacket );
+
+    /// \brief      The topic, data and size of the last COMPLETE message.
+    const Topic& MessageTopic() const { return topic_; }
+    const uint8_t* MessageData() const { return buffer_; }
+    size_t MessageSize() const { return size_; }
+
+    /// \returns    The number of partial messages and stray fragments discarded since construction.
+    uint32_t Discarded() const { return discarded_; }
+
+    /// \brief      Called by EmbeddedSerialFiller whenever a message has been reassembled.
+    etl::delegate<void( const Topic& topic, const uint8_t* data, size_t size )> messageReceived_;
+
+    /// \returns    The most data a fragment can carry in packets of \p packetSize bytes once COBS encoded, no more
+    ///             than ESF_FRAGMENT_SIZE, or 0 if the header and longest topic don't leave room for any.
+    static constexpr size_t FragmentSize( size_t packetSize )
+    {
+        return ( packetSize <= 2 ) || ( ( packetSize - 2 ) * 254 / 255 <= HEADER_SIZE + ESF_MAX_TOPIC_LENGTH + 2 )
+                   ? 0
+                   : ( ( ( packetSize - 2 ) * 254 / 255 - HEADER_SIZE - ESF_MAX_TOPIC_LENGTH - 2 < ESF_FRAGMENT_SIZE )
+                           ? ( packetSize - 2 ) * 254 / 255 - HEADER_SIZE - ESF_MAX_TOPIC_LENGTH - 2
+                           : ESF_FRAGMENT_SIZE );
+    }
+
+    /// \returns    The number of fragments of \p fragmentSize needed to send \p size bytes.
+    static size_t FragmentCount( size_t size, size_t fragmentSize = ESF_FRAGMENT_SIZE ) { return size ? ( ( size + fragmentSize - 1 ) / fragmentSize ) : 1; }
+
+    /// \brief      Builds a single fragment of a message split into \p fragmentSize pieces in \p packet, then CRCs and
+    ///             COBS encodes it into \p encodedData.
+    static void EncodeFragment( uint8_t messageId, uint16_t index, uint16_t count, const Topic& topic, const uint8_t* data, size_t size, size_t fragmentSize,
+                                IByteArray& packet, IByteArray& encodedData );
+
+   private:
+    static_assert( ESF_FRAGMENT_SIZE > 0, "ESF_FRAGMENT_SIZE must not be 0" );
+
+    uint8_t* buffer_;
+    size_t capacity_;
+    size_t size_;
+
+    bool inProgress_;
+    uint8_t messageId_;
+    uint16_t nextIndex_;
+    uint16_t count_;
+    Topic topic_;
+
+    uint32_t discarded_;
+
+    Progress Discard();
+};
+
+}  // namespace esf
+
+#endif  // #ifndef ESF_FRAGMENT_ASSEMBLER_H
@@ -0,0 +1,115 @@
+/**
+ * \file    FramePool.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_FRAME_POOL_H
+#define ESF_FRAME_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esf
+{
+/// \brief A fixed number of statically allocated packet buffers, shared by the receive and transmit paths of every
+///        node of a Config, see Config::FRAMES.
+/// \details
+/// GiveRxData() holds two frames while it handles a packet, one for the packet (and its data, once split from the
+/// topic) and one for the decoded packet. Each transmit holds two while it builds the packet and one while the packet
+/// is emitted. So a node acknowledging a PUBLISH from within GiveRxData() needs four, a callback that publishes or a
+/// loopback nests another transmit and GiveRxData() inside, and each thread in the library at the same time needs
+/// its own. The default, ESF_FRAME_POOL_SIZE, allows for ESF_MAX_RX_DEPTH of them. Publish() returns 0 and
+/// GiveRxData() returns ERROR_NO_FREE_FRAMES when the pool runs dry.
+///
+/// Not thread safe itself, the node only acquires and releases frames with its Config::Lock held.
+template <typename Buffer, size_t Size>
+class BasicFramePool
+{
+   public:
+    static_assert( Size > 0, "A node needs frames to send or receive anything" );
+
+    /// \brief      Holds a frame from acquisition until it goes out of scope (or Release() is called).
+    class Handle
+    {
+       public:
+        explicit Handle( BasicFramePool& pool ) : pool_( pool ), frame_( pool.Acquire() ) {}
+        ~Handle() { Release(); }
+
+        /// \returns    False if the pool had no free frames.
+        explicit operator bool() const { return frame_ != nullptr; }
+        Buffer& operator*() const { return *frame_; }
+        Buffer* operator->() const { return frame_; }
+
+        /// \brief      Returns the frame to the pool early.
+        void Release()
+        {
+            if( frame_ != nullptr )
+            {
+                pool_.Release( frame_ );
+                frame_ = nullptr;
+            }
+        }
+
+       private:
+        Handle( const Handle& );
+        Handle& operator=( const Handle& );
+
+        BasicFramePool& pool_;
+        Buffer* frame_;
+    };
+
+    BasicFramePool() : available_( Size ), lowWater_( Size ), misses_( 0 )
+    {
+        for( size_t i = 0; i < Size; ++i )
+        {
+            used_[ i ] = false;
+        }
+    }
+
+    /// \returns    An empty frame, or nullptr if they are all in use.
+    Buffer* Acquire()
+    {
+        for( size_t i = 0; i < Size; ++i )
+        {
+            if( !used_[ i ] )
+            {
+                used_[ i ] = true;
+                if( --available_ < lowWater_ )
+                {
+                    lowWater_ = available_;
+                }
+                frames_[ i ].clear();
+                return &frames_[ i ];
+            }
+        }
+        ++misses_;
+        return nullptr;
+    }
+
+    void Release( Buffer* frame )
+    {
+        used_[ frame - frames_ ] = false;
+        ++available_;
+    }
+
+    /// \returns    The number of frames not in use.
+    size_t Available() const { return available_; }
+
+    /// \returns    The fewest frames there have ever been available, to tune Config::FRAMES by.
+    size_t LowWater() const { return lowWater_; }
+
+    /// \returns    The number of times a frame was wanted but none were free, each dropping a packet.
+    uint32_t Misses() const { return misses_; }
+
+   private:
+    Buffer frames_[ Size ];
+    bool used_[ Size ];
+    size_t available_;
+    size_t lowWater_;
+    uint32_t misses_;
+};
+
+}  // namespace esf
+
+#endif  // #ifndef ESF_FRAME_POOL_H
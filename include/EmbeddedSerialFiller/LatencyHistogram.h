@@ -0,0 +1,118 @@
+/**
+ * \file    LatencyHistogram.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_LATENCY_HISTOGRAM_H
+#define ESF_LATENCY_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "EmbeddedSerialFiller/Definitions.h"
+
+namespace esf
+{
+/// \brief The distribution of a link's ACK round trip times, in fixed memory (after HdrHistogram).
+/// \details
+/// Values below 2^(SubBits + 1) each have a bucket of their own. Above that, each power of two is split into 2^SubBits
+/// equal buckets, so a bucket is never wider than 1 / 2^SubBits of the values in it. Values of more than Bits bits
+/// are counted in the last bucket. The defaults (ESF_LATENCY_BITS and ESF_LATENCY_SUB_BITS) take 112 buckets, from
+/// 1 ms steps at the bottom to within 12.5% at 65 s. Units are those of RttEstimator's samples.
+template <size_t Bits, size_t SubBits>
+class BasicLatencyHistogram
+{
+    static_assert( ( SubBits < Bits ) && ( Bits <= 32 ), "A LatencyHistogram needs fewer sub bucket bits than bits" );
+
+   public:
+    static const uint32_t SUB_BUCKETS = 1u << SubBits;
+    static const size_t BUCKETS = ( Bits - SubBits + 1 ) * SUB_BUCKETS;
+
+    BasicLatencyHistogram() { Reset(); }
+
+    /// \brief      Forgets every value.
+    void Reset()
+    {
+        for( size_t i = 0; i < BUCKETS; ++i )
+        {
+            buckets_[ i ] = 0;
+        }
+        count_ = 0;
+        min_ = 0;
+        max_ = 0;
+    }
+
+    void Add( uint32_t value )
+    {
+        ++buckets_[ Bucket( value ) ];
+        min_ = ( ( count_ == 0 ) || ( value < min_ ) ) ? value : min_;
+        max_ = ( value > max_ ) ? value : max_;
+        ++count_;
+    }
+
+    /// \returns    A value that \p percent of those added were no larger than, rounded up to the end of its bucket
+    ///             (but no more than Max()), or 0 if none have been added.
+    uint32_t Percentile( uint32_t percent ) const
+    {
+        // The first bucket whose count, with those below it, reaches percent of the values.
+        uint32_t wanted = static_cast<uint32_t>( ( static_cast<uint64_t>( count_ ) * percent + 99 ) / 100 );
+        wanted = ( wanted == 0 ) ? 1 : wanted;
+        uint32_t seen = 0;
+        for( size_t i = 0; ( i < BUCKETS ) && ( seen < count_ ); ++i )
+        {
+            seen += buckets_[ i ];
+            if( seen >= wanted )
+            {
+                uint32_t upper = Upper( i );
+                return ( upper < max_ ) ? upper : max_;
+            }
+        }
+        return max_;
+    }
+
+    uint32_t Count() const { return count_; }
+    uint32_t Min() const { return count_ ? min_ : 0; }
+    uint32_t Max() const { return max_; }
+
+    /// \returns    The number of values added in bucket \p index.
+    uint32_t operator[]( size_t index ) const { return buckets_[ index ]; }
+
+    /// \returns    The bucket \p value is counted in.
+    static size_t Bucket( uint32_t value )
+    {
+        // A value is shifted down to its top SubBits + 1 bits, the shift saying how many sets of SUB_BUCKETS come
+        // before its own.
+        size_t shift = 0;
+        while( ( value >> shift ) >= ( SUB_BUCKETS << 1 ) )
+        {
+            ++shift;
+        }
+        size_t index = shift * SUB_BUCKETS + ( value >> shift );
+        return ( index < BUCKETS ) ? index : BUCKETS - 1;
+    }
+
+    /// \returns    The largest value counted in bucket \p index.
+    static uint32_t Upper( size_t index )
+    {
+        if( index >= BUCKETS - 1 )
+        {
+            return UINT32_MAX;
+        }
+        size_t shift = ( index < ( SUB_BUCKETS << 1 ) ) ? 0 : index / SUB_BUCKETS - 1;
+        uint32_t first = static_cast<uint32_t>( index - shift * SUB_BUCKETS );
+        return ( ( first + 1 ) << shift ) - 1;
+    }
+
+   private:
+    uint32_t buckets_[ BUCKETS ];
+    uint32_t count_;
+    uint32_t min_;
+    uint32_t max_;
+};
+
+typedef BasicLatencyHistogram<ESF_LATENCY_BITS, ESF_LATENCY_SUB_BITS> LatencyHistogram;
+
+}  // namespace esf
+
+#endif  // #ifndef ESF_LATENCY_HISTOGRAM_H
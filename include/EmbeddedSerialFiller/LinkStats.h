@@ -0,0 +1,174 @@
+/**
+ * \file    LinkStats.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_LINK_STATS_H
+#define ESF_LINK_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "EmbeddedSerialFiller/Definitions.h"
+
+namespace esf
+{
+/// \brief The number of StatusCodes, which LinkStats::errors is indexed by.
+#if defined( ESF_REJECT_INCOMPLETE_PACKETS )
+const size_t STATUS_CODES = static_cast<size_t>( StatusCode::ERROR_PACKET_INCOMPLETE ) + 1;
+#else
+const size_t STATUS_CODES = static_cast<size_t>( StatusCode::ERROR_NO_FREE_FRAMES ) + 1;
+#endif
+
+/// \brief What a node has sent and received, as read by BasicEmbeddedSerialFiller::Stats().
+/// \details    The counts wrap at 2^32, so compare two reads by subtracting them, which stays right across a wrap.
+struct LinkStats
+{
+    /// \brief      Frames found in the data given to GiveRxData(), whether they turned out valid or not.
+    uint32_t framesIn;
+    /// \brief      Bytes given to GiveRxData().
+    uint32_t bytesIn;
+    /// \brief      Frames, and their bytes, passed to txDataReady_.
+    uint32_t framesOut;
+    uint32_t bytesOut;
+    /// \brief      What GiveRxData() returned other than SUCCESS, and packets not sent for want of a frame
+    ///             (ERROR_NO_FREE_FRAMES), by StatusCode.
+    uint32_t errors[ STATUS_CODES ];
+    /// \brief      PublishWait() and PublishReliable() calls that gave up without an ACK.
+    uint32_t ackTimeouts;
+    /// \brief      Packets resent by PublishReliable(), and stream frames resent by Poll().
+    uint32_t retransmits;
+    /// \brief      The most bytes the receive buffer has held, a whole frame or what is left over at the end of a call.
+    uint32_t rxHighWater;
+
+    uint32_t Errors( StatusCode code ) const { return errors[ static_cast<size_t>( code ) ]; }
+};
+
+/// \brief The live counts behind a node's LinkStats, in the Counter of its Config::Lock (see LockPolicy.h).
+/// \details
+/// Updated by the node with its lock held, so one at a time. Read() takes no lock, so a monitoring thread never holds
+/// up traffic. Each update is bracketed by a sequence count, odd while it is being made (a sequence lock), and Read()
+/// copies again if the count changed while it copied. So a read has every count as of one moment, never a frame
+/// counted and its bytes not.
+template <typename Counter>
+class BasicLinkCounters
+{
+   public:
+    /// \brief      The end of a GiveRxData() call, given \p bytes, that returned \p result and left \p buffered in
+    ///             the receive buffer.
+    void Received( size_t bytes, StatusCode result, size_t buffered )
+    {
+        Begin();
+        Add( bytesIn_, bytes );
+        if( result != StatusCode::SUCCESS )
+        {
+            Add( errors_[ static_cast<size_t>( result ) ], 1 );
+        }
+        Max( rxHighWater_, buffered );
+        End();
+    }
+
+    /// \brief      A frame of \p size bytes found in the received data.
+    void Frame( size_t size )
+    {
+        Begin();
+        Add( framesIn_, 1 );
+        Max( rxHighWater_, size );
+        End();
+    }
+
+    /// \brief      A frame of \p size bytes passed to txDataReady_.
+    void Sent( size_t size )
+    {
+        Begin();
+        Add( framesOut_, 1 );
+        Add( bytesOut_, size );
+        End();
+    }
+
+    /// \brief      An error not returned from GiveRxData(), such as a packet dropped on the transmit side.
+    void Error( StatusCode code )
+    {
+        Begin();
+        Add( errors_[ static_cast<size_t>( code ) ], 1 );
+        End();
+    }
+
+    void AckTimeout()
+    {
+        Begin();
+        Add( ackTimeouts_, 1 );
+        End();
+    }
+
+    void Retransmit()
+    {
+        Begin();
+        Add( retransmits_, 1 );
+        End();
+    }
+
+    LinkStats Read() const
+    {
+        LinkStats stats;
+        uint32_t before;
+        uint32_t after;
+        do
+        {
+            before = sequence_.Load();
+            Counter::AcquireFence();
+            stats.framesIn = framesIn_.Load();
+            stats.bytesIn = bytesIn_.Load();
+            stats.framesOut = framesOut_.Load();
+            stats.bytesOut = bytesOut_.Load();
+            for( size_t i = 0; i < STATUS_CODES; ++i )
+            {
+                stats.errors[ i ] = errors_[ i ].Load();
+            }
+            stats.ackTimeouts = ackTimeouts_.Load();
+            stats.retransmits = retransmits_.Load();
+            stats.rxHighWater = rxHighWater_.Load();
+            Counter::AcquireFence();
+            after = sequence_.Load();
+        } while( ( before != after ) || ( before & 1 ) );
+        return stats;
+    }
+
+   private:
+    void Begin()
+    {
+        sequence_.Store( sequence_.Load() + 1 );
+        Counter::ReleaseFence();
+    }
+
+    void End()
+    {
+        Counter::ReleaseFence();
+        sequence_.Store( sequence_.Load() + 1 );
+    }
+
+    static void Add( Counter& counter, size_t value ) { counter.Store( counter.Load() + static_cast<uint32_t>( value ) ); }
+
+    static void Max( Counter& counter, size_t value )
+    {
+        if( value > counter.Load() )
+        {
+            counter.Store( static_cast<uint32_t>( value ) );
+        }
+    }
+
+    Counter sequence_;
+    Counter framesIn_;
+    Counter bytesIn_;
+    Counter framesOut_;
+    Counter bytesOut_;
+    Counter errors_[ STATUS_CODES ];
+    Counter ackTimeouts_;
+    Counter retransmits_;
+    Counter rxHighWater_;
+};
+
+}  // namespace esf
+
+#endif  // #ifndef ESF_LINK_STATS_H
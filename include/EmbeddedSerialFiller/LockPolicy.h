@@ -0,0 +1,239 @@
+/**
+ * \file    LockPolicy.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_LOCK_POLICY_H
+#define ESF_LOCK_POLICY_H
+
+#include <cstdint>
+
+#include "esf_abstraction.h"
+
+#if !defined( PROFILE_NO_RTOS )
+#include <atomic>
+#include <chrono>
+#endif
+
+namespace esf
+{
+/// \brief Stands in for a condition variable where a lock policy has nothing to block on.
+struct NoSignal
+{
+    void notify_all() {}
+};
+
+/// \brief A LinkStats counter of a policy whose nodes are only read where they are updated, or from code an ISR updating
+///        them interrupts on a single core. Volatile, so a reader sees each update as it is made.
+class PlainCounter
+{
+   public:
+    PlainCounter() : value_( 0 ) {}
+    uint32_t Load() const { return value_; }
+    void Store( uint32_t value ) { value_ = value; }
+    static void ReleaseFence() {}
+    static void AcquireFence() {}
+
+   private:
+    volatile uint32_t value_;
+};
+
+#if !defined( PROFILE_NO_RTOS )
+/// \brief A LinkStats counter read from other threads than the one updating it, without taking the lock. Updates
+///        are only made with the lock held, so a relaxed load and store do, with no read-modify-write.
+class RelaxedCounter
+{
+   public:
+    RelaxedCounter() : value_( 0 ) {}
+    uint32_t Load() const { return value_.load( std::memory_order_relaxed ); }
+    void Store( uint32_t value ) { value_.store( value, std::memory_order_relaxed ); }
+    static void ReleaseFence() { std::atomic_thread_fence( std::memory_order_release ); }
+    static void AcquireFence() { std::atomic_thread_fence( std::memory_order_acquire ); }
+
+   private:
+    std::atomic<uint32_t> value_;
+};
+#endif
+
+// Lock policies, chosen by a Config's Lock typedef, guard the state of a BasicEmbeddedSerialFiller. Each is held
+// once per Config, shared by all of its nodes, and provides:
+//     Counter What each of the node's LinkStats is counted in, PlainCounter or RelaxedCounter.
+//     Signal  What a PublishWait() blocks on, notified when its ACK arrives.
+//     Guard   Taken on entry to each API method and released on exit. Its unlock()/lock() release the policy
+//             around callbacks, and Wait( signal, done, timeout ) releases it until done is set or timeout ms pass.
+// The node passes its SetThreadSafetyEnabled() flag to each Guard, which only MutexLock looks at.
+
+/// \brief No locking, for a node only ever used from one thread. Every Guard call compiles away.
+/// \details    An ACK can only arrive from within the publish that expects it (a loopback), so Wait() does not block
+///             for the timeout. Without the ACK it gives up the CPU for a tick, so a caller waiting out a timeout in a
+///             loop (PublishReliable()) sleeps rather than spins.
+struct NoLock
+{
+    typedef PlainCounter Counter;
+    typedef NoSignal Signal;
+
+    void Create() {}
+
+    class Guard
+    {
+       public:
+        Guard( NoLock&, bool ) {}
+        void lock() {}
+        void unlock() {}
+        bool Wait( Signal&, const bool& done, uint32_t )
+        {
+#if !defined( PROFILE_NO_RTOS )
+            if( !done )
+            {
+                ESF_SLEEP_TICK();
+            }
+#endif
+            return done;
+        }
+    };
+};
+
+#if !defined( PROFILE_NO_RTOS )
+/// \brief The OS mutex and condition variable of esf_abstraction.h, which may be turned off at run time with
+///        SetThreadSafetyEnabled(). The default.
+class MutexLock
+{
+   public:
+    typedef RelaxedCounter Counter;
+    typedef ESF_CONDITION_VARIABLE Signal;
+
+    void Create() { ESF_CONSTRUCTOR( mutex_ ); }
+
+    class Guard
+    {
+       public:
+        Guard( MutexLock& policy, bool enabled ) : lock_( policy.mutex_, ESF_DEFER_LOCK ), enabled_( enabled )
+        {
+            lock();
+        }
+        void lock()
+        {
+            if( enabled_ )
+                lock_.lock();
+        }
+        void unlock()
+        {
+            if( enabled_ )
+                lock_.unlock();
+        }
+        bool Wait( Signal& signal, const bool& done, uint32_t timeout )
+        {
+            // Look at done before each wait, as it may have been set (and the signal notified) before Wait() was
+            // entered, and after, as a wakeup may be spurious. The OS condition variables have no predicate wait_for.
+            uint32_t start = ESF_CLOCK_MS();
+            while( !done )
+            {
+                uint32_t waited = ESF_CLOCK_MS() - start;
+                if( waited >= timeout )
+                {
+                    break;
+                }
+                if( enabled_ )
+                {
+                    signal.wait_for( lock_, std::chrono::milliseconds( timeout - waited ) );
+                }
+                else
+                {
+                    // Without the mutex there's nothing to wait on the signal with, so poll.
+                    ESF_SLEEP_TICK();
+                }
+            }
+            return done;
+        }
+
+       private:
+        ESF_LOCK lock_;
+        bool enabled_;
+    };
+
+   private:
+    ESF_MUTEX mutex_;
+};
+
+/// \brief A spinlock, for nodes shared between threads on a multi-core part without an OS mutex to hand (or where
+///        the callbacks are short enough that a mutex costs more than it saves).
+/// \details    Wait() polls, releasing the lock between each look at \p done.
+class SpinLock
+{
+   public:
+    typedef RelaxedCounter Counter;
+    typedef NoSignal Signal;
+
+    SpinLock() { flag_.clear(); }
+
+    void Create() {}
+
+    class Guard
+    {
+       public:
+        Guard( SpinLock& policy, bool ) : flag_( policy.flag_ ) { lock(); }
+        ~Guard() { unlock(); }
+        void lock()
+        {
+            while( flag_.test_and_set( std::memory_order_acquire ) )
+            {
+            }
+        }
+        void unlock() { flag_.clear( std::memory_order_release ); }
+        bool Wait( Signal&, const bool& done, uint32_t timeout )
+        {
+            uint32_t start = ESF_CLOCK_MS();
+            while( !done && ( ( ESF_CLOCK_MS() - start ) < timeout ) )
+            {
+                unlock();
+                lock();
+            }
+            return done;
+        }
+
+       private:
+        std::atomic_flag& flag_;
+    };
+
+   private:
+    std::atomic_flag flag_;
+};
+#endif
+
+#if defined( ESF_ENTER_CRITICAL )
+/// \brief Masks interrupts, via ESF_ENTER_CRITICAL()/ESF_EXIT_CRITICAL(), for a node fed by GiveRxData() from an
+///        ISR on a single core part.
+/// \details    esf_embos_abstraction.h defines the macros, other ports define them (usable from an ISR) to enable
+///             this policy. Callbacks run with interrupts unmasked. Wait() polls, as SpinLock.
+struct CriticalSectionLock
+{
+    typedef PlainCounter Counter;
+    typedef NoSignal Signal;
+
+    void Create() {}
+
+    class Guard
+    {
+       public:
+        Guard( CriticalSectionLock&, bool ) { lock(); }
+        ~Guard() { unlock(); }
+        void lock() { ESF_ENTER_CRITICAL(); }
+        void unlock() { ESF_EXIT_CRITICAL(); }
+        bool Wait( Signal&, const bool& done, uint32_t timeout )
+        {
+            uint32_t start = ESF_CLOCK_MS();
+            while( !done && ( ( ESF_CLOCK_MS() - start ) < timeout ) )
+            {
+                unlock();
+                lock();
+            }
+            return done;
+        }
+    };
+};
+#endif
+
+}  // namespace esf
+
+#endif  // #ifndef ESF_LOCK_POLICY_H
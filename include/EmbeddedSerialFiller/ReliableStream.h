@@ -0,0 +1,128 @@
+/**
+ * \file    ReliableStream.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_RELIABLE_STREAM_H
+#define ESF_RELIABLE_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "EmbeddedSerialFiller/CobsTranscoder.h"
+#include "EmbeddedSerialFiller/Definitions.h"
+#include "EmbeddedSerialFiller/Utilities.h"
+
+namespace esf
+{
+/// \brief Selective-repeat sliding window used by EmbeddedSerialFiller::PublishStream().
+/// \details
+/// Streams are opt-in, both ends of a link must attach one with EmbeddedSerialFiller::AttachStream().
+/// Up to ESF_STREAM_WINDOW_SIZE frames may be unacknowledged at any one time. Every frame is acknowledged
+/// individually, only frames whose retransmission timer expires are resent and the receiver holds
+/// out-of-order frames back so that subscribers always see them in sequence order. Each window slot holds a packet
+/// of up to PacketSize bytes, the packet size of the nodes it is attached to.
+///
+/// Stream packet structure:
+/// [ 0x53, <sequence MSB>, <sequence LSB>, <length of topic id>, <topic ID 1>, ..., <data n>, <CRC MSB>, <CRC LSB> ]
+/// Stream acknowledge packet structure:
+/// [ 0x73, <sequence MSB>, <sequence LSB>, <CRC MSB>, <CRC LSB> ]
+template <size_t PacketSize>
+class BasicReliableStream
+{
+   public:
+    typedef etl::vector<uint8_t, PacketSize> Frame;
+
+    /// \brief What the receive window did with a STREAM packet.
+    enum class RxVerdict : uint8_t
+    {
+        ACCEPTED,       // New frame within the receive window, acknowledge it.
+        DUPLICATE,      // Already received (our ACK was probably lost), acknowledge it again.
+        OUT_OF_WINDOW,  // Neither, ignore it.
+    };
+
+    /// \param  retransmitTimeout   Time, in the units given to Tick(), before an unacknowledged frame is resent.
+    explicit BasicReliableStream( uint32_t retransmitTimeout );
+
+    /// \brief      Discards all in-flight and buffered frames and restarts both sequences at zero.
+    void Reset();
+
+    /// \brief      Reserves the next sequence number.
+    /// \returns    The buffer to store the encoded frame in, or nullptr if the transmit window is full.
+    Frame* TxAllocate( uint16_t& sequence );
+
+    /// \brief      Marks a frame as acknowledged and slides the transmit window past every acknowledged frame.
+    void TxAcknowledge( uint16_t sequence );
+
+    /// \brief      Advances the retransmission timers of all unacknowledged frames.
+    void Tick( uint32_t elapsed );
+
+    /// \returns    The next frame whose timer has expired (restarting its timer), or nullptr if there are none.
+    const Frame* TxNextRetransmit();
+
+    /// \returns    The number of frames sent but not yet acknowledged.
+    uint16_t TxInFlight() const { return static_cast<uint16_t>( txNext_ - txBase_ ); }
+
+    /// \brief      Offers a received (COBS decoded, CRC verified) STREAM packet to the receive window.
+    RxVerdict RxAccept( uint16_t sequence, const IByteArray& decodedPacket );
+
+    /// \returns    The next packet in sequence order if it has been received, otherwise nullptr.
+    const Frame* RxNextInOrder() const;
+
+    /// \brief      Releases the packet returned by RxNextInOrder(), moving the receive window on by one.
+    void RxRelease();
+
+    /// \returns    The total number of frames resent since construction.
+    uint32_t Retransmissions() const { return retransmissions_; }
+
+    /// \brief      Builds a STREAM or STREAM_ACK packet in \p packet, then CRCs and COBS encodes it into \p encodedData.
+    static void EncodeFrame( PacketType packetType, uint16_t sequence, const Topic* topic, const IByteArray* data, IByteArray& packet, IByteArray& encodedData );
+
+   private:
+    static_assert( ( ESF_STREAM_WINDOW_SIZE & ( ESF_STREAM_WINDOW_SIZE - 1 ) ) == 0, "ESF_STREAM_WINDOW_SIZE must be a power of 2" );
+    static_assert( ESF_STREAM_WINDOW_SIZE <= 0x8000, "ESF_STREAM_WINDOW_SIZE must not exceed half the sequence space" );
+
+    struct TxSlot
+    {
+        bool acked;
+        uint32_t timer;
+        Frame frame;
+    };
+
+    struct RxSlot
+    {
+        bool filled;
+        Frame packet;
+    };
+
+    TxSlot txSlots_[ ESF_STREAM_WINDOW_SIZE ];
+    RxSlot rxSlots_[ ESF_STREAM_WINDOW_SIZE ];
+
+    /// \brief      Oldest unacknowledged sequence number.
+    uint16_t txBase_;
+    /// \brief      Sequence number given to the next frame sent.
+    uint16_t txNext_;
+    /// \brief      Sequence number of the next frame to deliver.
+    uint16_t rxBase_;
+
+    uint32_t retransmitTimeout_;
+    uint32_t retransmissions_;
+
+    static size_t SlotIndex( uint16_t sequence ) { return sequence & ( ESF_STREAM_WINDOW_SIZE - 1 ); }
+};
+
+/// \brief The ReliableStream for packets of up to ESF_MAX_PACKET_SIZE bytes.
+typedef BasicReliableStream<ESF_MAX_PACKET_SIZE> ReliableStream;
+
+}  // namespace esf
+
+#include "EmbeddedSerialFiller/ReliableStream.tpp"
+
+namespace esf
+{
+// Built once, in ReliableStream.cpp.
+extern template class BasicReliableStream<ESF_MAX_PACKET_SIZE>;
+}  // namespace esf
+
+#endif  // #ifndef ESF_RELIABLE_STREAM_H
@@ -0,0 +1,160 @@
+/**
+ * \file    ReliableStream.tpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+namespace esf
+{
+template <size_t PacketSize>
+BasicReliableStream<PacketSize>::BasicReliableStream( uint32_t retransmitTimeout )
+    : txBase_( 0 ), txNext_( 0 ), rxBase_( 0 ), retransmitTimeout_( retransmitTimeout ? retransmitTimeout : 1 ), retransmissions_( 0 )
+{
+    Reset();
+}
+
+template <size_t PacketSize>
+void BasicReliableStream<PacketSize>::Reset()
+{
+    for( size_t i = 0; i < ESF_STREAM_WINDOW_SIZE; ++i )
+    {
+        txSlots_[ i ].acked = false;
+        txSlots_[ i ].timer = 0;
+        txSlots_[ i ].frame.clear();
+        rxSlots_[ i ].filled = false;
+        rxSlots_[ i ].packet.clear();
+    }
+    txBase_ = 0;
+    txNext_ = 0;
+    rxBase_ = 0;
+}
+
+template <size_t PacketSize>
+typename BasicReliableStream<PacketSize>::Frame* BasicReliableStream<PacketSize>::TxAllocate( uint16_t& sequence )
+{
+    if( TxInFlight() >= ESF_STREAM_WINDOW_SIZE )
+    {
+        return nullptr;
+    }
+    sequence = txNext_;
+    ++txNext_;
+
+    TxSlot& slot = txSlots_[ SlotIndex( sequence ) ];
+    slot.acked = false;
+    slot.timer = retransmitTimeout_;
+    slot.frame.clear();
+    return &slot.frame;
+}
+
+template <size_t PacketSize>
+void BasicReliableStream<PacketSize>::TxAcknowledge( uint16_t sequence )
+{
+    // Ignore anything outside of [txBase_, txNext_), e.g. a repeated ACK for a frame we've already released.
+    if( static_cast<uint16_t>( sequence - txBase_ ) >= TxInFlight() )
+    {
+        return;
+    }
+    txSlots_[ SlotIndex( sequence ) ].acked = true;
+
+    while( ( txBase_ != txNext_ ) && txSlots_[ SlotIndex( txBase_ ) ].acked )
+    {
+        TxSlot& slot = txSlots_[ SlotIndex( txBase_ ) ];
+        slot.acked = false;
+        slot.frame.clear();
+        ++txBase_;
+    }
+}
+
+template <size_t PacketSize>
+void BasicReliableStream<PacketSize>::Tick( uint32_t elapsed )
+{
+    for( uint16_t sequence = txBase_; sequence != txNext_; ++sequence )
+    {
+        TxSlot& slot = txSlots_[ SlotIndex( sequence ) ];
+        if( !slot.acked )
+        {
+            slot.timer = ( slot.timer > elapsed ) ? slot.timer - elapsed : 0;
+        }
+    }
+}
+
+template <size_t PacketSize>
+const typename BasicReliableStream<PacketSize>::Frame* BasicReliableStream<PacketSize>::TxNextRetransmit()
+{
+    for( uint16_t sequence = txBase_; sequence != txNext_; ++sequence )
+    {
+        TxSlot& slot = txSlots_[ SlotIndex( sequence ) ];
+        if( !slot.acked && ( slot.timer == 0 ) )
+        {
+            slot.timer = retransmitTimeout_;
+            ++retransmissions_;
+            return &slot.frame;
+        }
+    }
+    return nullptr;
+}
+
+template <size_t PacketSize>
+typename BasicReliableStream<PacketSize>::RxVerdict BasicReliableStream<PacketSize>::RxAccept( uint16_t sequence, const IByteArray& decodedPacket )
+{
+    if( static_cast<uint16_t>( sequence - rxBase_ ) < ESF_STREAM_WINDOW_SIZE )
+    {
+        RxSlot& slot = rxSlots_[ SlotIndex( sequence ) ];
+        if( slot.filled )
+        {
+            return RxVerdict::DUPLICATE;
+        }
+        slot.packet.assign( decodedPacket.begin(), decodedPacket.end() );
+        slot.filled = true;
+        return RxVerdict::ACCEPTED;
+    }
+    else if( static_cast<uint16_t>( rxBase_ - sequence ) <= ESF_STREAM_WINDOW_SIZE )
+    {
+        // Already delivered, the sender can't have seen our ACK.
+        return RxVerdict::DUPLICATE;
+    }
+    return RxVerdict::OUT_OF_WINDOW;
+}
+
+template <size_t PacketSize>
+const typename BasicReliableStream<PacketSize>::Frame* BasicReliableStream<PacketSize>::RxNextInOrder() const
+{
+    const RxSlot& slot = rxSlots_[ SlotIndex( rxBase_ ) ];
+    return slot.filled ? &slot.packet : nullptr;
+}
+
+template <size_t PacketSize>
+void BasicReliableStream<PacketSize>::RxRelease()
+{
+    RxSlot& slot = rxSlots_[ SlotIndex( rxBase_ ) ];
+    if( slot.filled )
+    {
+        slot.filled = false;
+        slot.packet.clear();
+        ++rxBase_;
+    }
+}
+
+template <size_t PacketSize>
+void BasicReliableStream<PacketSize>::EncodeFrame( PacketType packetType, uint16_t sequence, const Topic* topic, const IByteArray* data, IByteArray& packet, IByteArray& encodedData )
+{
+    packet.clear();
+    packet.emplace_back( static_cast<uint8_t>( packetType ) );
+    // Sequence number, MSB first.
+    packet.emplace_back( static_cast<uint8_t>( ( sequence >> 8 ) & 0xFF ) );
+    packet.emplace_back( static_cast<uint8_t>( ( sequence >> 0 ) & 0xFF ) );
+    if( topic != nullptr )
+    {
+        packet.emplace_back( static_cast<uint8_t>( topic->size() ) );
+        packet.insert( packet.end(), topic->begin(), topic->end() );
+    }
+    if( data != nullptr )
+    {
+        packet.insert( packet.end(), data->begin(), data->end() );
+    }
+
+    Utilities::AddCrc( packet );
+    CobsTranscoder::Encode( packet, encodedData );
+}
+
+}  // namespace esf
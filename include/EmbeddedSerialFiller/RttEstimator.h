@@ -0,0 +1,55 @@
+/**
+ * \file    RttEstimator.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_RTT_ESTIMATOR_H
+#define ESF_RTT_ESTIMATOR_H
+
+#include <cstdint>
+
+#include "EmbeddedSerialFiller/Definitions.h"
+
+namespace esf
+{
+/// \brief Smoothed round trip time and retransmission timeout for a link (after RFC 6298).
+/// \details
+/// SRTT and RTTVAR are kept in fixed point (scaled by 8 and 4 respectively) so no floating point is needed:
+/// RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R|, SRTT = 7/8 SRTT + 1/8 R and RTO = SRTT + 4 RTTVAR, bounded by the
+/// minimum and maximum. Units are whatever the samples are measured in; milliseconds for the RTOS
+/// implementation and call cycles for PROFILE_NO_RTOS.
+/// Samples must only be taken from packets that were not retransmitted (Karn's algorithm).
+class RttEstimator
+{
+   public:
+    RttEstimator( uint32_t initialRto = ESF_RTO_INITIAL, uint32_t minRto = ESF_RTO_MIN, uint32_t maxRto = ESF_RTO_MAX );
+
+    /// \brief      Forgets all samples and sets the timeout limits.
+    void Reset( uint32_t initialRto, uint32_t minRto, uint32_t maxRto );
+
+    /// \brief      Adds a measured round trip time.
+    void AddSample( uint32_t rtt );
+
+    /// \returns    The current retransmission timeout.
+    uint32_t Rto() const { return rto_; }
+
+    /// \returns    The timeout to use after \p rto expired, i.e. double it, no more than the maximum.
+    uint32_t Backoff( uint32_t rto ) const;
+
+    uint32_t SmoothedRtt() const { return srtt8_ >> 3; }
+    uint32_t RttVariance() const { return rttvar4_ >> 2; }
+    uint32_t Samples() const { return samples_; }
+
+   private:
+    uint32_t srtt8_;
+    uint32_t rttvar4_;
+    uint32_t rto_;
+    uint32_t minRto_;
+    uint32_t maxRto_;
+    uint32_t samples_;
+};
+
+}  // namespace esf
+
+#endif  // #ifndef ESF_RTT_ESTIMATOR_H
@@ -0,0 +1,124 @@
+/**
+ * \file    StaticRegistry.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_STATIC_REGISTRY_H
+#define ESF_STATIC_REGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+
+namespace esf
+{
+/// \brief A topic known at build time, identified on the wire by the byte 0xC0 | \p Id in place of its string.
+/// \details
+/// \p PayloadType must be trivially copyable, it is sent as its raw bytes so both ends must agree on its layout.
+/// \p Handler is called with every payload received, leave it as nullptr for topics this node only publishes.
+template <uint8_t Id, typename PayloadType, void ( *Handler )( const PayloadType& ) = nullptr>
+struct StaticTopic
+{
+    static_assert( Id <= ( 0xFF & ~ESF_STATIC_TOPIC_FLAG ), "Static topic IDs run from 0 to 0x3F" );
+
+    typedef PayloadType Payload;
+    static const uint8_t ID = Id;
+
+    /// \returns    False if this node doesn't handle the topic, or the payload is the wrong size.
+    static bool Invoke( const uint8_t* data, size_t size )
+    {
+        if( ( Handler == nullptr ) || ( size != sizeof( Payload ) ) )
+        {
+            return false;
+        }
+        Payload payload;
+        memcpy( &payload, data, sizeof( Payload ) );
+        Handler( payload );
+        return true;
+    }
+};
+
+/// \brief The complete set of StaticTopic's used by a node, declared once as a type:
+/// \code
+/// using Registry = esf::StaticRegistry< esf::StaticTopic< 0, ImuSample, &OnImu >,
+///                                       esf::StaticTopic< 1, Heartbeat > >;
+/// Registry::Attach( node );
+/// Registry::Publish< esf::StaticTopic< 1, Heartbeat > >( node, heartbeat );
+/// \endcode
+/// Dispatch() compiles to a comparison per topic (or a jump table) calling each handler directly, so received
+/// packets need no Topic, subscriber list, delegate or string compare, and the registry itself takes no RAM.
+/// Static topics are sent as BROADCASTs (see EmbeddedSerialFiller::PublishStatic()), both nodes must be built
+/// with the same registry.
+template <typename... Topics>
+class StaticRegistry;
+
+template <>
+class StaticRegistry<>
+{
+   public:
+    static bool Dispatch( uint8_t, const uint8_t*, size_t ) { return false; }
+
+    template <typename T>
+    struct Contains
+    {
+        static const bool value = false;
+    };
+
+    template <uint8_t Id>
+    struct HasId
+    {
+        static const bool value = false;
+    };
+
+    static const bool UNIQUE_IDS = true;
+};
+
+template <typename First, typename... Rest>
+class StaticRegistry<First, Rest...>
+{
+   public:
+    /// \brief      Calls the handler of topic \p topicId.
+    /// \returns    False if the topic isn't handled by this node, or its payload was the wrong size.
+    static bool Dispatch( uint8_t topicId, const uint8_t* data, size_t size )
+    {
+        return ( topicId == First::ID ) ? First::Invoke( data, size ) : StaticRegistry<Rest...>::Dispatch( topicId, data, size );
+    }
+
+    /// \brief      Has received static topics dispatched by this registry.
+    template <typename Node>
+    static void Attach( Node& node )
+    {
+        node.AttachRegistry( &Dispatch );
+    }
+
+    /// \brief      Publishes \p payload on topic \p T, which must be in the registry.
+    template <typename T, typename Node>
+    static uint8_t Publish( Node& node, const typename T::Payload& payload )
+    {
+        static_assert( Contains<T>::value, "Topic is not in the registry" );
+        return node.PublishStatic( T::ID, reinterpret_cast<const uint8_t*>( &payload ), sizeof( payload ) );
+    }
+
+    template <typename T>
+    struct Contains
+    {
+        static const bool value = std::is_same<T, First>::value || StaticRegistry<Rest...>::template Contains<T>::value;
+    };
+
+    template <uint8_t Id>
+    struct HasId
+    {
+        static const bool value = ( Id == First::ID ) || StaticRegistry<Rest...>::template HasId<Id>::value;
+    };
+
+    static const bool UNIQUE_IDS = !StaticRegistry<Rest...>::template HasId<First::ID>::value && StaticRegistry<Rest...>::UNIQUE_IDS;
+    static_assert( UNIQUE_IDS, "Static topic IDs must be unique" );
+};
+
+}  // namespace esf
+
+#endif  // #ifndef ESF_STATIC_REGISTRY_H
@@ -0,0 +1,95 @@
+/**
+ * \file    TopicDictionary.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_TOPIC_DICTIONARY_H
+#define ESF_TOPIC_DICTIONARY_H
+
+#include <cstdint>
+
+#include "EmbeddedSerialFiller/Definitions.h"
+
+namespace esf
+{
+/// \brief Numeric topic IDs negotiated at runtime, see EmbeddedSerialFiller::AttachDictionary().
+/// \details
+/// The first time a topic is published it is announced to the remote node with a TOPIC_ANNOUNCE packet, the data
+/// itself still carrying the topic string. Once the remote node has confirmed the announcement with a TOPIC_ACK,
+/// BROADCAST/PUBLISH packets carry the single byte 0x80 | <topic ID> in place of the topic's length and string.
+/// Topic lengths never exceed 0x7F, so the two forms can't be confused. Topics that don't fit the dictionary, or are
+/// published to a node that never confirms them, simply keep using the string.
+/// Each direction has its own set of IDs, a node only ever sends the IDs it has announced itself.
+///
+/// Topic announce packet structure:
+/// [ 0x54, <topic ID>, <length of topic id>, <topic ID 1>, ..., <CRC MSB>, <CRC LSB> ]
+/// Topic acknowledge packet structure, 0x80 is set when rejecting an unknown ID:
+/// [ 0x74, <topic ID>, <CRC MSB>, <CRC LSB> ]
+class TopicDictionary
+{
+   public:
+    /// \brief Marks a topic ID in place of the topic length.
+    static const uint8_t TOPIC_ID_FLAG = 0x80;
+
+    /// \brief How TxLookup() says a topic should be sent.
+    enum class TxAction : uint8_t
+    {
+        SEND_STRING,  // Not (yet) confirmed, send the topic string.
+        ANNOUNCE,     // Send a TOPIC_ANNOUNCE, then the topic string.
+        SEND_ID,      // Confirmed, send the topic ID.
+    };
+
+    TopicDictionary();
+
+    /// \brief      Forgets all topics, in both directions.
+    void Reset();
+
+    /// \brief      Finds (or allocates) the topic's ID, deciding how it should be sent.
+    TxAction TxLookup( const Topic& topic, uint8_t& topicId );
+
+    /// \brief      The remote node has learnt the ID, it can be used from now on.
+    void TxConfirm( uint8_t topicId );
+
+    /// \brief      The remote node doesn't know the ID (e.g. it has restarted), announce it again on next use.
+    void TxReject( uint8_t topicId );
+
+    /// \brief      Records an ID announced by the remote node.
+    /// \returns    False if the ID is beyond ESF_MAX_TOPIC_IDS (the remote node's may be larger), so must be rejected.
+    bool RxLearn( uint8_t topicId, const Topic& topic );
+
+    /// \returns    The topic announced for \p topicId, or nullptr if it is unknown.
+    const Topic* RxResolve( uint8_t topicId ) const;
+
+   private:
+    static_assert( ESF_MAX_TOPIC_LENGTH < TOPIC_ID_FLAG, "Topic lengths must leave the top bit free for topic IDs" );
+    static_assert( ESF_MAX_TOPIC_IDS <= 0x40, "Topic IDs 0xC0 and above are reserved" );
+
+    enum class TxState : uint8_t
+    {
+        UNUSED,
+        ANNOUNCED,
+        CONFIRMED,
+    };
+
+    struct TxEntry
+    {
+        TxState state;
+        /// \brief      Times used since last announced, see ESF_TOPIC_ANNOUNCE_RETRY.
+        uint8_t uses;
+        Topic topic;
+    };
+
+    struct RxEntry
+    {
+        bool known;
+        Topic topic;
+    };
+
+    TxEntry tx_[ ESF_MAX_TOPIC_IDS ];
+    RxEntry rx_[ ESF_MAX_TOPIC_IDS ];
+};
+
+}  // namespace esf
+
+#endif  // #ifndef ESF_TOPIC_DICTIONARY_H
@@ -0,0 +1,86 @@
+/**
+ * \file    TopicProfiler.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_TOPIC_PROFILER_H
+#define ESF_TOPIC_PROFILER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "EmbeddedSerialFiller/Definitions.h"
+
+#if defined( ESF_TOPIC_PROFILER ) && !defined( ESF_PROFILER_CLOCK )
+#error "ESF_TOPIC_PROFILER needs ESF_PROFILER_CLOCK(), see Definitions.h"
+#endif
+
+namespace esf
+{
+/// \brief Counts the messages and bytes received on each topic, and how long its subscribers' callbacks take, to find
+///        the topics that cost GiveRxData() the most.
+/// \details
+/// Attached to a node with AttachProfiler(), which only exists when the library is built with ESF_TOPIC_PROFILER,
+/// so that without it there is no profiling code or data at all. Times are in ESF_PROFILER_CLOCK() ticks.
+/// The first ESF_PROFILER_TOPICS topics received are profiled; messages on any more are only counted by Overflows().
+/// Not thread safe itself, the node only updates it with its lock held.
+class TopicProfiler
+{
+   public:
+    /// \brief      Callback times are counted in power of two buckets, the last holding everything longer.
+    static const size_t BUCKETS = 16;
+
+    struct Profile
+    {
+        Topic topic;
+        uint32_t messages;
+        uint32_t bytes;
+        /// \brief      Callbacks called, so the fan-out is deliveries / messages.
+        uint32_t deliveries;
+        /// \brief      Time spent in callbacks.
+        uint32_t ticks;
+        uint32_t maxTicks;
+        /// \brief      histogram[ 0 ] counts callbacks taking 0 ticks, histogram[ i ] those taking 2^(i-1) to 2^i - 1.
+        uint32_t histogram[ BUCKETS ];
+
+        /// \returns    A callback time that \p percent of the callbacks took no longer than, to within a factor of 2.
+        uint32_t Percentile( uint32_t percent ) const;
+    };
+
+    TopicProfiler();
+
+    /// \brief      Forgets every topic, starting a new period.
+    void Reset();
+
+    /// \brief      A message of \p size bytes received on \p topic at \p now, before its callbacks are called.
+    /// \returns    The topic's profile, or nullptr if there's no room for a new topic.
+    Profile* Message( const Topic& topic, size_t size, uint32_t now );
+
+    /// \brief      A callback for \p profile's topic that took \p ticks.
+    void Callback( Profile& profile, uint32_t ticks );
+
+    /// \brief      Fills \p hottest with the \p count topics whose callbacks took the most time, the most first.
+    /// \returns    How many were filled, fewer than \p count if fewer topics were received.
+    size_t Hottest( const Profile* hottest[], size_t count ) const;
+
+    size_t Topics() const { return topics_; }
+    const Profile& operator[]( size_t index ) const { return profiles_[ index ]; }
+
+    /// \returns    The ticks from the first message after Reset() to the last, to turn the counts into rates.
+    uint32_t Elapsed() const { return last_ - first_; }
+
+    /// \returns    Messages on topics there was no room for.
+    uint32_t Overflows() const { return overflows_; }
+
+   private:
+    Profile profiles_[ ESF_PROFILER_TOPICS ];
+    size_t topics_;
+    uint32_t first_;
+    uint32_t last_;
+    uint32_t overflows_;
+};
+
+}  // namespace esf
+
+#endif  // #ifndef ESF_TOPIC_PROFILER_H
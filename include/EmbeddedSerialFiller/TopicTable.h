@@ -0,0 +1,142 @@
+/**
+ * \file    TopicTable.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_TOPIC_TABLE_H
+#define ESF_TOPIC_TABLE_H
+
+#include <etl/delegate.h>
+
+#include <algorithm>
+#include <cstdint>
+
+#include "EmbeddedSerialFiller/Definitions.h"
+
+namespace esf
+{
+/// \returns    The smallest power of 2 no less than \p n.
+static constexpr size_t TopicTablePowerOf2( size_t n, size_t p = 1 ) { return ( p >= n ) ? p : TopicTablePowerOf2( n, p << 1 ); }
+
+template <typename Config>
+class BasicEmbeddedSerialFiller;
+
+/// \brief A topic prepared once by EmbeddedSerialFiller::RegisterTopic(), so that publishing or subscribing with it
+///        neither builds a Topic string nor hashes it on every call, and publishing copies the topic into the packet
+///        as a single block.
+class TopicHandle
+{
+   public:
+    const Topic& Name() const { return topic_; }
+    uint32_t Hash() const { return hash_; }
+
+   private:
+    template <typename Config>
+    friend class BasicEmbeddedSerialFiller;
+
+    TopicHandle( const Topic& topic, uint32_t hash ) : topic_( topic ), hash_( hash )
+    {
+        encoded_[ 0 ] = static_cast<uint8_t>( topic.size() );
+        std::copy( topic.begin(), topic.end(), encoded_ + 1 );
+    }
+
+    Topic topic_;
+    uint32_t hash_;
+    /// \brief      The topic as it is sent, its length followed by its characters.
+    uint8_t encoded_[ ESF_MAX_TOPIC_LENGTH + 1 ];
+};
+
+/// \brief Subscribers grouped by topic, for EmbeddedSerialFiller::Subscribe() and the dispatch of received packets.
+/// \details
+/// Up to \p MaxTopics topics, each with up to \p MaxSubscribers subscribers taking a \p Payload, are held in a
+/// fixed array. They are found through an open addressing (linear probing) index of at least twice that many
+/// slots, keyed by a FNV-1a hash of the topic, so a lookup costs one hash plus (on average) a single string compare
+/// however many topics there are. Subscriber IDs encode the topic's entry, so removing a subscriber doesn't need
+/// a search either.
+template <size_t MaxTopics, size_t MaxSubscribers, typename Payload>
+class BasicTopicTable
+{
+   public:
+    typedef etl::delegate<void( Payload& )> Callback;
+
+    struct Subscriber
+    {
+        uint32_t id_;
+        Callback callback_;
+    };
+    typedef etl::vector<Subscriber, MaxSubscribers> SubscriberList;
+
+    /// \brief      Returned by Add() when there's no room for the subscriber.
+    static const uint32_t INVALID_ID = 0xFFFFFFFF;
+
+    BasicTopicTable();
+
+    /// \brief      Adds a subscriber to a topic, adding the topic if need be.
+    /// \returns    A unique subscriber ID, or INVALID_ID if either the topic or its subscribers are full.
+    uint32_t Add( const Topic& topic, Callback callback ) { return Add( topic, Hash( topic ), callback ); }
+    uint32_t Add( const Topic& topic, uint32_t hash, Callback callback );
+
+    /// \brief      Removes a subscriber, and its topic once it has no subscribers left.
+    /// \returns    False if there is no such subscriber.
+    bool Remove( uint32_t subscriberId );
+
+    /// \brief      Removes every subscriber of a topic, and the topic.
+    /// \returns    False if the topic has no subscribers.
+    bool RemoveTopic( const Topic& topic, uint32_t hash );
+
+    /// \returns    The subscribers of \p topic, or nullptr if it has none.
+    const SubscriberList* Find( const Topic& topic ) const { return Find( topic, Hash( topic ) ); }
+    const SubscriberList* Find( const Topic& topic, uint32_t hash ) const;
+
+    /// \brief      Removes all topics and subscribers.
+    void Clear();
+
+    /// \returns    The number of topics with at least one subscriber.
+    size_t Size() const { return MaxTopics - freeCount_; }
+
+    /// \returns    The length of the probe sequence a lookup of \p topic walks, including the empty slot ending it.
+    size_t ProbeLength( const Topic& topic ) const;
+
+    /// \returns    The 32 bit FNV-1a hash of \p topic.
+    static uint32_t Hash( const Topic& topic );
+
+   private:
+    static_assert( MaxTopics < 0xFF, "Subscriber IDs hold the entry index in 8 bits" );
+
+    // At most half full, so probe sequences stay short.
+    static const size_t NUM_SLOTS = TopicTablePowerOf2( 2 * MaxTopics );
+    static const uint8_t EMPTY = 0xFF;
+
+    struct Entry
+    {
+        uint32_t hash;
+        Topic topic;
+        SubscriberList subscribers;
+    };
+
+    Entry entries_[ MaxTopics ];
+    /// \brief      Stack of unused entries.
+    uint8_t free_[ MaxTopics ];
+    size_t freeCount_;
+    /// \brief      The index, each slot holds an entry index or EMPTY.
+    uint8_t slots_[ NUM_SLOTS ];
+
+    /// \brief      Incremented for every subscriber added, forming the upper bits of its ID.
+    uint32_t nextSerial_;
+
+    /// \returns    The slot indexing \p topic, or NUM_SLOTS if it isn't in the table.
+    size_t FindSlot( const Topic& topic, uint32_t hash ) const;
+
+    /// \brief      Returns the entry indexed by \p slot to the free stack.
+    void Release( size_t slot );
+};
+
+/// \brief The TopicTable of an EmbeddedSerialFiller with the DefaultConfig.
+typedef BasicTopicTable<ESF_MAX_SUBSCRIBERS, ESF_MAX_SUBSCRIBERS, ByteArray> TopicTable;
+
+}  // namespace esf
+
+#include "EmbeddedSerialFiller/TopicTable.tpp"
+
+#endif  // #ifndef ESF_TOPIC_TABLE_H
@@ -0,0 +1,186 @@
+/**
+ * \file    TopicTable.tpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+namespace esf
+{
+template <size_t MaxTopics, size_t MaxSubscribers, typename Payload>
+const uint32_t BasicTopicTable<MaxTopics, MaxSubscribers, Payload>::INVALID_ID;
+
+template <size_t MaxTopics, size_t MaxSubscribers, typename Payload>
+BasicTopicTable<MaxTopics, MaxSubscribers, Payload>::BasicTopicTable() : freeCount_( 0 ), nextSerial_( 0 )
+{
+    Clear();
+}
+
+template <size_t MaxTopics, size_t MaxSubscribers, typename Payload>
+void BasicTopicTable<MaxTopics, MaxSubscribers, Payload>::Clear()
+{
+    for( size_t i = 0; i < MaxTopics; ++i )
+    {
+        entries_[ i ].subscribers.clear();
+        entries_[ i ].topic.clear();
+        free_[ i ] = static_cast<uint8_t>( MaxTopics - 1 - i );
+    }
+    freeCount_ = MaxTopics;
+    for( size_t i = 0; i < NUM_SLOTS; ++i )
+    {
+        slots_[ i ] = EMPTY;
+    }
+}
+
+template <size_t MaxTopics, size_t MaxSubscribers, typename Payload>
+uint32_t BasicTopicTable<MaxTopics, MaxSubscribers, Payload>::Add( const Topic& topic, uint32_t hash, Callback callback )
+{
+    size_t slot = FindSlot( topic, hash );
+    uint8_t index;
+    if( slot < NUM_SLOTS )
+    {
+        index = slots_[ slot ];
+        if( entries_[ index ].subscribers.full() )
+        {
+            return INVALID_ID;
+        }
+    }
+    else
+    {
+        if( freeCount_ == 0 )
+        {
+            return INVALID_ID;
+        }
+        // The topic isn't present, so the first slot not in use will do.
+        slot = hash & ( NUM_SLOTS - 1 );
+        while( slots_[ slot ] != EMPTY )
+        {
+            slot = ( slot + 1 ) & ( NUM_SLOTS - 1 );
+        }
+        index = free_[ --freeCount_ ];
+        slots_[ slot ] = index;
+        entries_[ index ].hash = hash;
+        entries_[ index ].topic = topic;
+    }
+
+    Subscriber subscriber;
+    subscriber.id_ = ( nextSerial_++ << 8 ) | index;
+    subscriber.callback_ = callback;
+    entries_[ index ].subscribers.push_back( subscriber );
+    return subscriber.id_;
+}
+
+template <size_t MaxTopics, size_t MaxSubscribers, typename Payload>
+bool BasicTopicTable<MaxTopics, MaxSubscribers, Payload>::Remove( uint32_t subscriberId )
+{
+    uint8_t index = static_cast<uint8_t>( subscriberId & 0xFF );
+    if( index >= MaxTopics )
+    {
+        return false;
+    }
+    Entry& entry = entries_[ index ];
+    for( auto it = entry.subscribers.begin(); it != entry.subscribers.end(); ++it )
+    {
+        if( it->id_ == subscriberId )
+        {
+            entry.subscribers.erase( it );
+            if( entry.subscribers.empty() )
+            {
+                Release( FindSlot( entry.topic, entry.hash ) );
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+template <size_t MaxTopics, size_t MaxSubscribers, typename Payload>
+bool BasicTopicTable<MaxTopics, MaxSubscribers, Payload>::RemoveTopic( const Topic& topic, uint32_t hash )
+{
+    size_t slot = FindSlot( topic, hash );
+    if( slot == NUM_SLOTS )
+    {
+        return false;
+    }
+    entries_[ slots_[ slot ] ].subscribers.clear();
+    Release( slot );
+    return true;
+}
+
+template <size_t MaxTopics, size_t MaxSubscribers, typename Payload>
+const typename BasicTopicTable<MaxTopics, MaxSubscribers, Payload>::SubscriberList* BasicTopicTable<MaxTopics, MaxSubscribers, Payload>::Find( const Topic& topic, uint32_t hash ) const
+{
+    size_t slot = FindSlot( topic, hash );
+    return ( slot < NUM_SLOTS ) ? &entries_[ slots_[ slot ] ].subscribers : nullptr;
+}
+
+template <size_t MaxTopics, size_t MaxSubscribers, typename Payload>
+void BasicTopicTable<MaxTopics, MaxSubscribers, Payload>::Release( size_t slot )
+{
+    uint8_t index = slots_[ slot ];
+    entries_[ index ].topic.clear();
+    free_[ freeCount_++ ] = index;
+
+    // Close the gap by moving the rest of the probe sequence back (backward shift deletion), rather than leaving a
+    // marker that lookups would have to step over until Clear(). An entry can fill the hole unless its own home slot
+    // lies after the hole.
+    size_t hole = slot;
+    size_t next = ( hole + 1 ) & ( NUM_SLOTS - 1 );
+    while( slots_[ next ] != EMPTY )
+    {
+        size_t home = entries_[ slots_[ next ] ].hash & ( NUM_SLOTS - 1 );
+        if( ( ( next - home ) & ( NUM_SLOTS - 1 ) ) >= ( ( next - hole ) & ( NUM_SLOTS - 1 ) ) )
+        {
+            slots_[ hole ] = slots_[ next ];
+            hole = next;
+        }
+        next = ( next + 1 ) & ( NUM_SLOTS - 1 );
+    }
+    slots_[ hole ] = EMPTY;
+}
+
+template <size_t MaxTopics, size_t MaxSubscribers, typename Payload>
+size_t BasicTopicTable<MaxTopics, MaxSubscribers, Payload>::ProbeLength( const Topic& topic ) const
+{
+    size_t slot = Hash( topic ) & ( NUM_SLOTS - 1 );
+    size_t length = 1;
+    while( ( slots_[ slot ] != EMPTY ) && ( length < NUM_SLOTS ) )
+    {
+        slot = ( slot + 1 ) & ( NUM_SLOTS - 1 );
+        ++length;
+    }
+    return length;
+}
+
+template <size_t MaxTopics, size_t MaxSubscribers, typename Payload>
+size_t BasicTopicTable<MaxTopics, MaxSubscribers, Payload>::FindSlot( const Topic& topic, uint32_t hash ) const
+{
+    size_t slot = hash & ( NUM_SLOTS - 1 );
+    for( size_t probes = 0; probes < NUM_SLOTS; ++probes )
+    {
+        uint8_t index = slots_[ slot ];
+        if( index == EMPTY )
+        {
+            break;
+        }
+        if( ( entries_[ index ].hash == hash ) && ( entries_[ index ].topic == topic ) )
+        {
+            return slot;
+        }
+        slot = ( slot + 1 ) & ( NUM_SLOTS - 1 );
+    }
+    return NUM_SLOTS;
+}
+
+template <size_t MaxTopics, size_t MaxSubscribers, typename Payload>
+uint32_t BasicTopicTable<MaxTopics, MaxSubscribers, Payload>::Hash( const Topic& topic )
+{
+    uint32_t hash = 2166136261u;
+    for( auto it = topic.begin(); it != topic.end(); ++it )
+    {
+        hash ^= static_cast<uint8_t>( *it );
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+}  // namespace esf
@@ -0,0 +1,114 @@
+/**
+ * \file    TopicTrie.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_TOPIC_TRIE_H
+#define ESF_TOPIC_TRIE_H
+
+#include <cstdint>
+
+#include "EmbeddedSerialFiller/Definitions.h"
+#include "EmbeddedSerialFiller/TopicTable.h"
+
+namespace esf
+{
+/// \brief Prefix (wildcard) subscriptions, e.g. "motor/*", for EmbeddedSerialFiller::Subscribe().
+/// \details
+/// A pattern is a topic ending in '*', matching every topic that starts with the characters before it ("*" alone
+/// matches everything). Up to ESF_MAX_WILDCARDS patterns are stored in a trie of ESF_MAX_TRIE_NODES nodes, held in a
+/// flat array with 8 bit first child/next sibling links, so matching a topic costs one step per character however
+/// many patterns there are. Exact topics stay in the TopicTable, whose type \p Table also gives the subscribers'.
+template <typename Table>
+class BasicTopicTrie
+{
+   public:
+    /// \brief      The low byte of every subscriber ID given out, distinguishing them from TopicTable IDs.
+    static const uint8_t ID_TAG = 0xFF;
+
+    typedef typename Table::Callback Callback;
+    typedef typename Table::Subscriber Subscriber;
+    typedef typename Table::SubscriberList SubscriberList;
+
+    BasicTopicTrie();
+
+    /// \returns    True if \p topic is a pattern.
+    static bool IsPattern( const Topic& topic ) { return !topic.empty() && ( topic.back() == '*' ); }
+
+    /// \brief      Adds a subscriber to a pattern, adding the pattern if need be.
+    /// \returns    A unique subscriber ID, or Table::INVALID_ID if the patterns, trie nodes or the pattern's
+    ///             subscribers are full.
+    uint32_t Add( const Topic& pattern, Callback callback );
+
+    /// \brief      Removes a subscriber, and its pattern once it has no subscribers left.
+    /// \returns    False if there is no such subscriber.
+    bool Remove( uint32_t subscriberId );
+
+    /// \brief      Removes every subscriber of a pattern, and the pattern.
+    /// \returns    False if the pattern has no subscribers.
+    bool RemovePattern( const Topic& pattern );
+
+    /// \brief      Finds the patterns matching \p topic.
+    /// \returns    The number of subscriber lists written to \p matches, at most ESF_MAX_WILDCARDS.
+    size_t Match( const Topic& topic, const SubscriberList* ( &matches )[ ESF_MAX_WILDCARDS ] ) const;
+
+    /// \brief      Removes all patterns and subscribers.
+    void Clear();
+
+    /// \returns    The number of trie nodes in use.
+    size_t Nodes() const { return numNodes_; }
+
+   private:
+    static_assert( ESF_MAX_TRIE_NODES < 0xFF, "Trie links are 8 bit" );
+    static_assert( ESF_MAX_WILDCARDS < 0xFF, "Pattern indices are 8 bit" );
+
+    static const uint8_t NONE = 0xFF;
+
+    struct Node
+    {
+        char c;
+        uint8_t child;
+        uint8_t sibling;
+        /// \brief      Index of the pattern ending at this node, or NONE.
+        uint8_t pattern;
+    };
+
+    struct Pattern
+    {
+        /// \brief      The pattern without its trailing '*', empty if unused.
+        Topic prefix;
+        bool used;
+        SubscriberList subscribers;
+    };
+
+    Node nodes_[ ESF_MAX_TRIE_NODES ];
+    size_t numNodes_;
+    /// \brief      First child of the (implicit) root node.
+    uint8_t root_;
+    /// \brief      Pattern matching every topic ("*"), or NONE.
+    uint8_t rootPattern_;
+
+    Pattern patterns_[ ESF_MAX_WILDCARDS ];
+
+    uint32_t nextSerial_;
+
+    /// \returns    The index of the pattern with \p prefix, or NONE.
+    uint8_t FindPattern( const Topic& prefix ) const;
+
+    /// \brief      Links pattern \p index into the trie.
+    /// \returns    False if there weren't enough free nodes.
+    bool Insert( uint8_t index );
+
+    /// \brief      Rebuilds the trie from the patterns in use, reclaiming the nodes of removed patterns.
+    void Rebuild();
+};
+
+/// \brief The TopicTrie of an EmbeddedSerialFiller with the DefaultConfig.
+typedef BasicTopicTrie<TopicTable> TopicTrie;
+
+}  // namespace esf
+
+#include "EmbeddedSerialFiller/TopicTrie.tpp"
+
+#endif  // #ifndef ESF_TOPIC_TRIE_H
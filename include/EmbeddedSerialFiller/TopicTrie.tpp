@@ -0,0 +1,213 @@
+/**
+ * \file    TopicTrie.tpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+namespace esf
+{
+template <typename Table>
+const uint8_t BasicTopicTrie<Table>::ID_TAG;
+
+template <typename Table>
+BasicTopicTrie<Table>::BasicTopicTrie() : numNodes_( 0 ), root_( NONE ), rootPattern_( NONE ), nextSerial_( 0 )
+{
+    Clear();
+}
+
+template <typename Table>
+void BasicTopicTrie<Table>::Clear()
+{
+    for( size_t i = 0; i < ESF_MAX_WILDCARDS; ++i )
+    {
+        patterns_[ i ].used = false;
+        patterns_[ i ].prefix.clear();
+        patterns_[ i ].subscribers.clear();
+    }
+    numNodes_ = 0;
+    root_ = NONE;
+    rootPattern_ = NONE;
+}
+
+template <typename Table>
+uint32_t BasicTopicTrie<Table>::Add( const Topic& pattern, Callback callback )
+{
+    Topic prefix( pattern.begin(), pattern.end() - 1 );
+    uint8_t index = FindPattern( prefix );
+    if( index == NONE )
+    {
+        for( index = 0; index < ESF_MAX_WILDCARDS; ++index )
+        {
+            if( !patterns_[ index ].used )
+            {
+                break;
+            }
+        }
+        if( index == ESF_MAX_WILDCARDS )
+        {
+            return Table::INVALID_ID;
+        }
+        patterns_[ index ].prefix = prefix;
+        if( !Insert( index ) )
+        {
+            patterns_[ index ].prefix.clear();
+            // Undo any nodes added before running out.
+            Rebuild();
+            return Table::INVALID_ID;
+        }
+        patterns_[ index ].used = true;
+    }
+    else if( patterns_[ index ].subscribers.full() )
+    {
+        return Table::INVALID_ID;
+    }
+
+    Subscriber subscriber;
+    subscriber.id_ = ( nextSerial_++ << 8 ) | ID_TAG;
+    subscriber.callback_ = callback;
+    patterns_[ index ].subscribers.push_back( subscriber );
+    return subscriber.id_;
+}
+
+template <typename Table>
+bool BasicTopicTrie<Table>::Remove( uint32_t subscriberId )
+{
+    if( ( subscriberId & 0xFF ) != ID_TAG )
+    {
+        return false;
+    }
+    for( size_t i = 0; i < ESF_MAX_WILDCARDS; ++i )
+    {
+        Pattern& pattern = patterns_[ i ];
+        for( auto it = pattern.subscribers.begin(); it != pattern.subscribers.end(); ++it )
+        {
+            if( it->id_ == subscriberId )
+            {
+                pattern.subscribers.erase( it );
+                if( pattern.subscribers.empty() )
+                {
+                    pattern.used = false;
+                    pattern.prefix.clear();
+                    Rebuild();
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <typename Table>
+bool BasicTopicTrie<Table>::RemovePattern( const Topic& pattern )
+{
+    uint8_t index = FindPattern( Topic( pattern.begin(), pattern.end() - 1 ) );
+    if( index == NONE )
+    {
+        return false;
+    }
+    patterns_[ index ].used = false;
+    patterns_[ index ].prefix.clear();
+    patterns_[ index ].subscribers.clear();
+    Rebuild();
+    return true;
+}
+
+template <typename Table>
+size_t BasicTopicTrie<Table>::Match( const Topic& topic, const SubscriberList* ( &matches )[ ESF_MAX_WILDCARDS ] ) const
+{
+    size_t count = 0;
+    if( rootPattern_ != NONE )
+    {
+        matches[ count++ ] = &patterns_[ rootPattern_ ].subscribers;
+    }
+
+    uint8_t node = root_;
+    for( auto it = topic.begin(); ( it != topic.end() ) && ( node != NONE ); ++it )
+    {
+        // Find the character amongst this level's siblings.
+        while( ( node != NONE ) && ( nodes_[ node ].c != *it ) )
+        {
+            node = nodes_[ node ].sibling;
+        }
+        if( node == NONE )
+        {
+            break;
+        }
+        if( nodes_[ node ].pattern != NONE )
+        {
+            matches[ count++ ] = &patterns_[ nodes_[ node ].pattern ].subscribers;
+        }
+        node = nodes_[ node ].child;
+    }
+    return count;
+}
+
+template <typename Table>
+uint8_t BasicTopicTrie<Table>::FindPattern( const Topic& prefix ) const
+{
+    for( uint8_t i = 0; i < ESF_MAX_WILDCARDS; ++i )
+    {
+        if( patterns_[ i ].used && ( patterns_[ i ].prefix == prefix ) )
+        {
+            return i;
+        }
+    }
+    return NONE;
+}
+
+template <typename Table>
+bool BasicTopicTrie<Table>::Insert( uint8_t index )
+{
+    const Topic& prefix = patterns_[ index ].prefix;
+    if( prefix.empty() )
+    {
+        rootPattern_ = index;
+        return true;
+    }
+
+    uint8_t* link = &root_;
+    uint8_t node = NONE;
+    for( auto it = prefix.begin(); it != prefix.end(); ++it )
+    {
+        // Find the character amongst this level's siblings, adding it if need be.
+        while( ( *link != NONE ) && ( nodes_[ *link ].c != *it ) )
+        {
+            link = &nodes_[ *link ].sibling;
+        }
+        if( *link == NONE )
+        {
+            if( numNodes_ == ESF_MAX_TRIE_NODES )
+            {
+                return false;
+            }
+            node = static_cast<uint8_t>( numNodes_++ );
+            nodes_[ node ].c = *it;
+            nodes_[ node ].child = NONE;
+            nodes_[ node ].sibling = NONE;
+            nodes_[ node ].pattern = NONE;
+            *link = node;
+        }
+        node = *link;
+        link = &nodes_[ node ].child;
+    }
+    nodes_[ node ].pattern = index;
+    return true;
+}
+
+template <typename Table>
+void BasicTopicTrie<Table>::Rebuild()
+{
+    numNodes_ = 0;
+    root_ = NONE;
+    rootPattern_ = NONE;
+    for( uint8_t i = 0; i < ESF_MAX_WILDCARDS; ++i )
+    {
+        if( patterns_[ i ].used )
+        {
+            // These fitted before, so they still do.
+            Insert( i );
+        }
+    }
+}
+
+}  // namespace esf
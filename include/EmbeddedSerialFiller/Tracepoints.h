@@ -0,0 +1,46 @@
+/**
+ * \file    Tracepoints.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_TRACEPOINTS_H
+#define ESF_TRACEPOINTS_H
+
+#include "EmbeddedSerialFiller/Definitions.h"
+
+/// \brief Static tracepoints on the receive, dispatch and transmit paths of a node.
+/// \details
+/// Each is ESF_TRACE( probe, node, arg1, arg2 ), node being the BasicEmbeddedSerialFiller, so that probes from the
+/// links of a gateway can be told apart. The probes, and their two arguments:
+///
+/// | Probe                   | arg1                      | arg2                                        |
+/// |-------------------------|---------------------------|---------------------------------------------|
+/// | frame                   | Encoded size              | Bytes still buffered after it               |
+/// | decoded                 | Decoded size              | StatusCode of the COBS decode               |
+/// | crc                     | Decoded size              | StatusCode of the CRC check                 |
+/// | ack_sent                | Packet ID, or block base  | Block bitmap, 0 for a single ACK            |
+/// | ack_matched             | Packet ID                 | 0                                           |
+/// | callback_entry          | Topic (const char*)       | Data size                                   |
+/// | callback_exit           | Topic (const char*)       | Data size                                   |
+/// | static_callback_entry   | StaticTopic ID            | Data size                                   |
+/// | static_callback_exit    | StaticTopic ID            | Data size                                   |
+/// | tx                      | Frame (const uint8_t*)    | Frame size                                  |
+///
+/// By default they compile to nothing. Defining ESF_USDT (the CMake option of that name) makes them USDT probes from
+/// <sys/sdt.h>, provider "esf", which cost a nop each until perf or bpftrace attaches to them, e.g.
+/// bpftrace -e 'usdt:./gateway:esf:crc /arg2 != 0/ { @bad[arg0] = count(); }'.
+/// Elsewhere, define ESF_TRACE() in the build to call a hook of your own, such as a trace buffer or a GPIO toggle.
+#if defined( ESF_TRACE )
+// Supplied by the build.
+#elif defined( ESF_USDT )
+#if !defined( __linux__ )
+#error "ESF_USDT needs Linux and <sys/sdt.h>, define ESF_TRACE() instead"
+#endif
+#include <sys/sdt.h>
+#define ESF_TRACE( probe, node, arg1, arg2 ) DTRACE_PROBE3( esf, probe, node, arg1, arg2 )
+#else
+#define ESF_TRACE( probe, node, arg1, arg2 ) do { } while( 0 )
+#endif
+
+#endif  // #ifndef ESF_TRACEPOINTS_H
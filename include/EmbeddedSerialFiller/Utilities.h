@@ -16,18 +16,25 @@ namespace esf
 class Utilities
 {
    public:
-    static StatusCode SplitPacket( const ByteArray& packet, uint32_t startAt, Topic& topic, ByteArray& data );
+    static StatusCode SplitPacket( const IByteArray& packet, uint32_t startAt, Topic& topic, IByteArray& data );
 
     /// \details    Moves new RX data into the RX buffer, while looking for the
     ///             end-of-frame character. If EOF is found, packet is populated
     ///             and this method returns.
-    static StatusCode MoveRxDataInBuffer( ByteArray& newRxData, ByteArray& rxDataBuffer, ByteArray& packet );
+    static StatusCode MoveRxDataInBuffer( IByteArray& newRxData, IByteArray& rxDataBuffer, IByteArray& packet );
 
-    static void AddCrc( ByteArray& packet );
+    static void AddCrc( IByteArray& packet );
 
     /// \param  packet  Packet must be COBS decoded before passing into here. Expects
     ///                 last two bytes to be the CRC value of all the bytes proceeding it.
-    static StatusCode VerifyCrc( const ByteArray& packet );
+    static StatusCode VerifyCrc( const IByteArray& packet );
+
+    /// \brief      VerifyCrc() for several packets at once, as when a burst of frames is ready together.
+    /// \details    Four packets are checked side by side, as independent dependency chains, which small packets
+    ///             (where the serial CRC chain is most of the cost) gain most from.
+    /// \param  packets COBS decoded packets, as VerifyCrc() takes them. Only the first 32 are checked.
+    /// \returns    A mask with bit i set if packets[ i ] passes. Packets too short to hold a CRC fail.
+    static uint32_t VerifyCrcs( const IByteArray* const packets[], size_t count );
 
     static const char* StatusCodeToString( StatusCode statusCode );
 };
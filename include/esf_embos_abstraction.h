@@ -20,6 +20,15 @@
 #define ESF_CONDITION_VARIABLE Embos_ConditionVariable
 #define ESF_NO_TIMEOUT 0
 #define ESF_CONSTRUCTOR Embos_Builder
+// Monotonic time in ms (assuming the usual 1ms system tick), used to measure round trip times.
+#define ESF_CLOCK_MS() static_cast<uint32_t>( OS_GetTime32() )
+// Monotonic time in us, used to time callbacks (see TopicProfiler.h).
+#define ESF_CLOCK_US() static_cast<uint32_t>( OS_GetTime_us() )
+// Gives up the CPU for a tick, where a wait has nothing to block on.
+#define ESF_SLEEP_TICK() OS_Delay( 1 )
+// Masks interrupts, for the CriticalSectionLock policy. Nests, and may be used from an ISR.
+#define ESF_ENTER_CRITICAL() OS_IncDI()
+#define ESF_EXIT_CRITICAL() OS_DecRI()
 
 void Embos_Builder( ESF_MUTEX& mutex );
 
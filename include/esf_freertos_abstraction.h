@@ -12,6 +12,7 @@
 #include "..\..\FreeRTOS\Source\include\FreeRTOS.h"
 #include "..\..\FreeRTOS\Source\include\event_groups.h"
 #include "..\..\FreeRTOS\Source\include\semphr.h"
+#include "..\..\FreeRTOS\Source\include\task.h"
 
 // A bare minimum implementation to support a mutex, lock & condition variable
 // using suitable embOS equivalents.
@@ -21,6 +22,12 @@
 #define ESF_DEFER_LOCK 1
 #define ESF_CONDITION_VARIABLE FreeRTOS_ConditionVariable
 #define ESF_NO_TIMEOUT 0
+// Monotonic time in ms, used to measure round trip times.
+#define ESF_CLOCK_MS() ( static_cast<uint32_t>( xTaskGetTickCount() ) * portTICK_PERIOD_MS )
+// Gives up the CPU for a tick, where a wait has nothing to block on.
+#define ESF_SLEEP_TICK() vTaskDelay( 1 )
+// There is no finer clock than the tick, so to use the TopicProfiler define ESF_PROFILER_CLOCK() in the build, e.g.
+// as the DWT cycle counter.
 
 class FreeRTOS_Lock
 {
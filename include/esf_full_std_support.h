@@ -7,8 +7,11 @@
 #ifndef __ESF_FULL_STD_SUPPORT_H__
 #define __ESF_FULL_STD_SUPPORT_H__
 
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
+#include <thread>
 
 // Used for any OS that fully supports the standard C++11 library.
 
@@ -17,6 +20,13 @@
 #define ESF_DEFER_LOCK std::defer_lock
 #define ESF_CONDITION_VARIABLE std::condition_variable
 #define ESF_NO_TIMEOUT std::cv_status::no_timeout
-#define ESF_CONSTRUCTOR
+// The standard mutex needs no construction step.
+#define ESF_CONSTRUCTOR( mutex )
+// Monotonic time in ms, used to measure round trip times.
+#define ESF_CLOCK_MS() static_cast<uint32_t>( std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() )
+// Monotonic time in us, used to time callbacks (see TopicProfiler.h).
+#define ESF_CLOCK_US() static_cast<uint32_t>( std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() )
+// Gives up the CPU for about a tick, where a wait has nothing to block on.
+#define ESF_SLEEP_TICK() std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) )
 
 #endif  // __ESF_FULL_STD_SUPPORT_H__
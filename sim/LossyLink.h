@@ -0,0 +1,334 @@
+/**
+ * \file    LossyLink.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_SIM_LOSSY_LINK_H
+#define ESF_SIM_LOSSY_LINK_H
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+
+// An in-process model of a noisy serial link between two nodes, for the tests and benchmarks. Uses the heap and the
+// standard library, so is not for a target.
+
+namespace esf_sim
+{
+/// \brief      A small, seeded generator (SplitMix64), giving the same noise for the same seed on every platform.
+class Random
+{
+   public:
+    explicit Random( uint64_t seed ) : state_( seed ) {}
+
+    uint64_t Next()
+    {
+        uint64_t z = ( state_ += 0x9E3779B97F4A7C15ull );
+        z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+        z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+        return z ^ ( z >> 31 );
+    }
+
+    /// \returns    A number in [0, 1).
+    double Uniform() { return ( Next() >> 11 ) * ( 1.0 / 9007199254740992.0 ); }
+
+    /// \returns    The number of trials before the next one to succeed, each with chance \p p. So an event with a
+    ///             chance per bit (or byte) can be placed without a draw for every bit.
+    uint64_t Skip( double p )
+    {
+        if( p <= 0.0 )
+        {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        if( p >= 1.0 )
+        {
+            return 0;
+        }
+        return static_cast<uint64_t>( std::log( 1.0 - Uniform() ) / std::log( 1.0 - p ) );
+    }
+
+   private:
+    uint64_t state_;
+};
+
+/// \brief      What happens to the bytes in one direction of a link. The default is a perfect link.
+struct ChannelModel
+{
+    ChannelModel()
+        : bitErrorRate( 0.0 ), byteDropRate( 0.0 ), burstRate( 0.0 ), burstBytes( 0 ), duplicateRate( 0.0 ), reorderRate( 0.0 ), reorderDelay( 0 ), latency( 0 ), baud( 0 )
+    {
+    }
+
+    /// \brief      Chance of each bit being flipped.
+    double bitErrorRate;
+    /// \brief      Chance of each byte being lost.
+    double byteDropRate;
+    /// \brief      Chance, at each byte, of a burst of noise starting, replacing burstBytes bytes with random ones.
+    double burstRate;
+    uint32_t burstBytes;
+    /// \brief      Chance of each frame arriving twice.
+    double duplicateRate;
+    /// \brief      Chance of each frame being held back by reorderDelay (us), letting the frames after it pass.
+    double reorderRate;
+    uint32_t reorderDelay;
+    /// \brief      Time (us) from a byte leaving to it arriving.
+    uint32_t latency;
+    /// \brief      Line rate, at 10 bits a byte (8N1), each frame waiting for the ones before it to be sent. 0 for
+    ///             no pacing.
+    uint32_t baud;
+};
+
+/// \brief      What a Channel did to the frames sent through it.
+struct ChannelStats
+{
+    ChannelStats() : frames( 0 ), bytes( 0 ), bitErrors( 0 ), droppedBytes( 0 ), bursts( 0 ), duplicated( 0 ), reordered( 0 ) {}
+
+    uint64_t frames;
+    uint64_t bytes;
+    uint64_t bitErrors;
+    uint64_t droppedBytes;
+    uint64_t bursts;
+    uint64_t duplicated;
+    uint64_t reordered;
+};
+
+/// \brief      One direction of a link: frames go in with Send() and come out, impaired by the ChannelModel, from
+///             Receive() once the (virtual) time they arrive has come.
+/// \details    Thread safe, so that a node may send from any thread.
+class Channel
+{
+   public:
+    enum : uint64_t
+    {
+        NEVER = UINT64_MAX
+    };
+
+    Channel( const ChannelModel& model, uint64_t seed )
+        : model_( model ), random_( seed ), order_( 0 ), lineFree_( 0 ), burstLeft_( 0 )
+    {
+        toBitError_ = random_.Skip( model_.bitErrorRate );
+        toDrop_ = random_.Skip( model_.byteDropRate );
+        toBurst_ = random_.Skip( model_.burstRate );
+    }
+
+    /// \brief      Sends a frame at time \p now (us).
+    void Send( const uint8_t* data, size_t size, uint64_t now )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        ++stats_.frames;
+        stats_.bytes += size;
+
+        std::vector<uint8_t> bytes;
+        bytes.reserve( size );
+        for( size_t i = 0; i < size; ++i )
+        {
+            uint8_t byte = Impair( data[ i ] );
+            if( toDrop_-- == 0 )
+            {
+                toDrop_ = random_.Skip( model_.byteDropRate );
+                ++stats_.droppedBytes;
+                continue;
+            }
+            bytes.push_back( byte );
+        }
+
+        uint64_t arrival = Transmit( size, now );
+        if( random_.Uniform() < model_.reorderRate )
+        {
+            ++stats_.reordered;
+            arrival += model_.reorderDelay;
+        }
+        if( random_.Uniform() < model_.duplicateRate )
+        {
+            ++stats_.duplicated;
+            arrivals_.insert( std::make_pair( std::make_pair( Transmit( size, now ), order_++ ), bytes ) );
+        }
+        arrivals_.insert( std::make_pair( std::make_pair( arrival, order_++ ), std::move( bytes ) ) );
+    }
+
+    /// \returns    The time (us) the next frame arrives, or NEVER if there are none in flight.
+    uint64_t NextArrival() const
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        uint64_t next = NEVER;
+        if( !arrivals_.empty() )
+        {
+            next = arrivals_.begin()->first.first;
+        }
+        return next;
+    }
+
+    /// \brief      Takes the next frame to have arrived by \p now (us).
+    /// \returns    False if none have.
+    bool Receive( uint64_t now, std::vector<uint8_t>& bytes )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        if( arrivals_.empty() || ( arrivals_.begin()->first.first > now ) )
+        {
+            return false;
+        }
+        bytes = std::move( arrivals_.begin()->second );
+        arrivals_.erase( arrivals_.begin() );
+        return true;
+    }
+
+    ChannelStats Stats() const
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        return stats_;
+    }
+
+   private:
+    uint8_t Impair( uint8_t byte )
+    {
+        if( burstLeft_ == 0 && toBurst_-- == 0 )
+        {
+            toBurst_ = random_.Skip( model_.burstRate );
+            burstLeft_ = model_.burstBytes;
+            ++stats_.bursts;
+        }
+        if( burstLeft_ != 0 )
+        {
+            --burstLeft_;
+            return static_cast<uint8_t>( random_.Next() );
+        }
+        // Skip the bit errors falling in this byte.
+        while( toBitError_ < 8 )
+        {
+            byte ^= static_cast<uint8_t>( 1u << toBitError_ );
+            ++stats_.bitErrors;
+            toBitError_ += 1 + random_.Skip( model_.bitErrorRate );
+        }
+        toBitError_ -= 8;
+        return byte;
+    }
+
+    /// \returns    The time a frame of \p size bytes sent at \p now arrives, taking the line for as long as it is sent.
+    uint64_t Transmit( size_t size, uint64_t now )
+    {
+        uint64_t start = lineFree_ > now ? lineFree_ : now;
+        lineFree_ = start + ( model_.baud ? size * 10000000ull / model_.baud : 0 );
+        return lineFree_ + model_.latency;
+    }
+
+    ChannelModel model_;
+    Random random_;
+    mutable std::mutex mutex_;
+    // Ordered by arrival time, then by when sent.
+    std::map<std::pair<uint64_t, uint64_t>, std::vector<uint8_t> > arrivals_;
+    uint64_t order_;
+    uint64_t lineFree_;
+    uint64_t toBitError_;
+    uint64_t toDrop_;
+    uint64_t toBurst_;
+    uint32_t burstLeft_;
+    ChannelStats stats_;
+};
+
+/// \brief      Joins two nodes' txDataReady_ to each other's GiveRxData() through a Channel each way, on a virtual
+///             clock (us) moved on by AdvanceTo().
+/// \details    Frames are only delivered from within AdvanceTo(), on the calling thread, so nothing sent re-enters a
+///             node. Poll() timers can follow the virtual clock exactly. PublishWait() and PublishReliable() time out
+///             on the OS clock, so to use those keep the virtual clock in step with it from a thread of its own.
+template <typename NodeA, typename NodeB>
+class LossyLink
+{
+   public:
+    LossyLink( NodeA& a, NodeB& b, const ChannelModel& model, uint64_t seed )
+        : a_( a ), b_( b ), toB_( model, seed ), toA_( model, seed ^ 0x5DEECE66Dull ), now_( 0 )
+    {
+        a_.txDataReady_ = etl::delegate<void( const typename NodeA::ByteArray& )>::template create<LossyLink, &LossyLink::FromA>( *this );
+        b_.txDataReady_ = etl::delegate<void( const typename NodeB::ByteArray& )>::template create<LossyLink, &LossyLink::FromB>( *this );
+    }
+
+    /// \returns    The virtual time (us).
+    uint64_t Now() const
+    {
+        std::lock_guard<std::mutex> lock( clockMutex_ );
+        return now_;
+    }
+
+    /// \brief      Moves the virtual clock on to \p time (us), delivering every frame arriving by then in turn.
+    void AdvanceTo( uint64_t time )
+    {
+        uint64_t next;
+        while( ( next = NextArrival() ) <= time )
+        {
+            SetNow( next );
+            if( toB_.NextArrival() == next )
+            {
+                Deliver( toB_, b_, next );
+            }
+            else
+            {
+                Deliver( toA_, a_, next );
+            }
+        }
+        if( time > Now() )
+        {
+            SetNow( time );
+        }
+    }
+
+    void Advance( uint64_t elapsed ) { AdvanceTo( Now() + elapsed ); }
+
+    /// \brief      Advances until nothing is in flight either way.
+    void RunUntilIdle()
+    {
+        uint64_t next;
+        while( ( next = NextArrival() ) != Channel::NEVER )
+        {
+            AdvanceTo( next );
+        }
+    }
+
+    /// \returns    The time (us) the next frame arrives either way, or Channel::NEVER.
+    uint64_t NextArrival() const
+    {
+        uint64_t toB = toB_.NextArrival();
+        uint64_t toA = toA_.NextArrival();
+        return toB < toA ? toB : toA;
+    }
+
+    Channel& ToA() { return toA_; }
+    Channel& ToB() { return toB_; }
+
+   private:
+    void FromA( const typename NodeA::ByteArray& frame ) { toB_.Send( frame.data(), frame.size(), Now() ); }
+    void FromB( const typename NodeB::ByteArray& frame ) { toA_.Send( frame.data(), frame.size(), Now() ); }
+
+    void SetNow( uint64_t time )
+    {
+        std::lock_guard<std::mutex> lock( clockMutex_ );
+        now_ = time;
+    }
+
+    template <typename Node>
+    static void Deliver( Channel& channel, Node& node, uint64_t now )
+    {
+        std::vector<uint8_t> bytes;
+        if( channel.Receive( now, bytes ) )
+        {
+            typename Node::ByteArray rxData( bytes.begin(), bytes.end() );
+            node.GiveRxData( rxData );
+        }
+    }
+
+    NodeA& a_;
+    NodeB& b_;
+    Channel toB_;
+    Channel toA_;
+    mutable std::mutex clockMutex_;
+    uint64_t now_;
+};
+
+}  // namespace esf_sim
+
+#endif  // #ifndef ESF_SIM_LOSSY_LINK_H
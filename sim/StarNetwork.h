@@ -0,0 +1,174 @@
+/**
+ * \file    StarNetwork.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_SIM_STAR_NETWORK_H
+#define ESF_SIM_STAR_NETWORK_H
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "LossyLink.h"
+
+// A controller with a serial link, and so a node, to each of many sensors, all in one process over LossyLinks. For
+// the scale tests and benchmarks; uses the heap and threads.
+
+namespace esf_sim
+{
+/// \brief      What the sensors and the controller publish, and how often.
+struct Traffic
+{
+    Traffic() : readingSize( 16 ), readingPeriod( 10 ), commandSize( 8 ), commandPeriod( 100 ) {}
+
+    /// \brief      Each sensor publishes a reading of readingSize bytes every readingPeriod ms, on "reading".
+    size_t readingSize;
+    uint32_t readingPeriod;
+    /// \brief      The controller publishes a command of commandSize bytes to each sensor every commandPeriod ms, on
+    ///             "command". A period of 0 sends none.
+    size_t commandSize;
+    uint32_t commandPeriod;
+};
+
+/// \brief      Totals over every link of a StarNetwork.
+struct StarStats
+{
+    StarStats() : readingsSent( 0 ), readingsReceived( 0 ), commandsSent( 0 ), commandsReceived( 0 ) {}
+
+    uint64_t readingsSent;
+    uint64_t readingsReceived;
+    uint64_t commandsSent;
+    uint64_t commandsReceived;
+};
+
+/// \brief      One controller node and one sensor node per sensor, each pair on a LossyLink of its own.
+/// \details    The nodes of each type share a Config, and so its static lock and frame pool, as many nodes in one
+///             process do. Run() can drive the links from several threads, contending for those.
+template <typename ControllerNode, typename SensorNode>
+class StarNetwork
+{
+   public:
+    StarNetwork( size_t sensors, const ChannelModel& model, uint64_t seed, const Traffic& traffic ) : traffic_( traffic ), now_( 0 )
+    {
+        for( size_t i = 0; i < sensors; ++i )
+        {
+            spokes_.push_back( std::unique_ptr<Spoke>( new Spoke( i, model, seed + i, traffic_ ) ) );
+        }
+    }
+
+    /// \brief      Runs every link for \p ms of virtual time, 1 ms at a time, the links split between \p threads.
+    /// \details    The links are independent, so each thread keeps its own time with no waiting on the others.
+    void Run( uint32_t ms, size_t threads )
+    {
+        if( threads <= 1 )
+        {
+            RunSpokes( 0, 1, ms );
+        }
+        else
+        {
+            std::vector<std::thread> workers;
+            for( size_t i = 0; i < threads; ++i )
+            {
+                workers.push_back( std::thread( &StarNetwork::RunSpokes, this, i, threads, ms ) );
+            }
+            for( auto& worker : workers )
+            {
+                worker.join();
+            }
+        }
+        now_ += ms;
+    }
+
+    /// \brief      Delivers everything in flight, publishing nothing more.
+    void Flush()
+    {
+        for( auto& spoke : spokes_ )
+        {
+            spoke->link_.RunUntilIdle();
+        }
+    }
+
+    /// \returns    The totals, only to be read between Run()s.
+    StarStats Stats() const
+    {
+        StarStats stats;
+        for( const auto& spoke : spokes_ )
+        {
+            stats.readingsSent += spoke->stats_.readingsSent;
+            stats.readingsReceived += spoke->stats_.readingsReceived;
+            stats.commandsSent += spoke->stats_.commandsSent;
+            stats.commandsReceived += spoke->stats_.commandsReceived;
+        }
+        return stats;
+    }
+
+    size_t Nodes() const { return spokes_.size() * 2; }
+
+   private:
+    typedef LossyLink<ControllerNode, SensorNode> Link;
+
+    /// \brief      A sensor, the controller's node for it and the link between them.
+    class Spoke
+    {
+       public:
+        Spoke( size_t index, const ChannelModel& model, uint64_t seed, const Traffic& traffic )
+            : link_( controller_, sensor_, model, seed ), index_( index ), reading_( traffic.readingSize, static_cast<uint8_t>( index ) ), command_( traffic.commandSize, static_cast<uint8_t>( index ) )
+        {
+            controller_.Subscribe( "reading", etl::delegate<void( typename ControllerNode::ByteArray& )>::template create<Spoke, &Spoke::OnReading>( *this ) );
+            sensor_.Subscribe( "command", etl::delegate<void( typename SensorNode::ByteArray& )>::template create<Spoke, &Spoke::OnCommand>( *this ) );
+        }
+
+        /// \brief      Publishes whatever is due at \p ms, spread across the period by index, and moves on 1 ms.
+        void Tick( uint64_t ms, const Traffic& traffic )
+        {
+            if( ( ( ms + index_ ) % traffic.readingPeriod ) == 0 )
+            {
+                sensor_.Publish( "reading", reading_ );
+                ++stats_.readingsSent;
+            }
+            if( ( traffic.commandPeriod != 0 ) && ( ( ( ms + index_ ) % traffic.commandPeriod ) == 0 ) )
+            {
+                controller_.Publish( "command", command_ );
+                ++stats_.commandsSent;
+            }
+            link_.Advance( 1000 );
+            controller_.Poll( 1 );
+            sensor_.Poll( 1 );
+        }
+
+        StarStats stats_;
+        // Declared after the nodes, as the link hooks into them.
+        ControllerNode controller_;
+        SensorNode sensor_;
+        Link link_;
+
+       private:
+        void OnReading( typename ControllerNode::ByteArray& ) { ++stats_.readingsReceived; }
+        void OnCommand( typename SensorNode::ByteArray& ) { ++stats_.commandsReceived; }
+
+        size_t index_;
+        typename SensorNode::ByteArray reading_;
+        typename ControllerNode::ByteArray command_;
+    };
+
+    void RunSpokes( size_t first, size_t step, uint32_t ms )
+    {
+        for( uint64_t tick = now_; tick < now_ + ms; ++tick )
+        {
+            for( size_t i = first; i < spokes_.size(); i += step )
+            {
+                spokes_[ i ]->Tick( tick, traffic_ );
+            }
+        }
+    }
+
+    Traffic traffic_;
+    std::vector<std::unique_ptr<Spoke> > spokes_;
+    uint64_t now_;
+};
+
+}  // namespace esf_sim
+
+#endif  // #ifndef ESF_SIM_STAR_NETWORK_H
@@ -0,0 +1,82 @@
+/**
+ * \file    AckAggregator.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/AckAggregator.h"
+
+namespace esf
+{
+// Packet IDs run from 1 to 255.
+static const uint8_t NUM_PACKET_IDS = 255;
+
+/// \returns    The number of IDs from \p from to \p to, skipping 0.
+static uint8_t Distance( uint8_t from, uint8_t to )
+{
+    return static_cast<uint8_t>( ( ( to - 1 ) - ( from - 1 ) + NUM_PACKET_IDS ) % NUM_PACKET_IDS );
+}
+
+AckAggregator::AckAggregator() : delay_( 0 ), timer_( 0 ), pending_( false ), base_( 0 ), bitmap_( 0 )
+{
+}
+
+bool AckAggregator::Add( uint8_t packetId )
+{
+    if( !pending_ )
+    {
+        pending_ = true;
+        base_ = packetId;
+        bitmap_ = 0;
+        timer_ = delay_;
+        return true;
+    }
+
+    uint8_t offset = Distance( base_, packetId );
+    if( offset == 0 )
+    {
+        // A repeat of the base.
+        return true;
+    }
+    if( offset > MAX_OFFSET )
+    {
+        return false;
+    }
+    bitmap_ = static_cast<uint16_t>( bitmap_ | ( 1u << ( offset - 1 ) ) );
+    return true;
+}
+
+bool AckAggregator::Tick( uint32_t elapsed )
+{
+    if( !pending_ )
+    {
+        return false;
+    }
+    timer_ = ( timer_ > elapsed ) ? timer_ - elapsed : 0;
+    return timer_ == 0;
+}
+
+void AckAggregator::Take( uint8_t& base, uint16_t& bitmap )
+{
+    base = base_;
+    bitmap = bitmap_;
+    pending_ = false;
+    bitmap_ = 0;
+}
+
+uint8_t AckAggregator::Advance( uint8_t packetId, uint8_t count )
+{
+    return static_cast<uint8_t>( ( ( packetId - 1 ) + count ) % NUM_PACKET_IDS + 1 );
+}
+
+bool AckAggregator::Contains( uint8_t base, uint16_t bitmap, uint8_t packetId )
+{
+    uint8_t offset = Distance( base, packetId );
+    if( offset == 0 )
+    {
+        return true;
+    }
+    return ( offset <= MAX_OFFSET ) && ( bitmap & ( 1u << ( offset - 1 ) ) );
+}
+
+}  // namespace esf
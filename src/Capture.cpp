@@ -0,0 +1,112 @@
+/**
+ * \file    Capture.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/Capture.h"
+
+namespace esf
+{
+namespace
+{
+const uint8_t MAGIC[] = { 'E', 'S', 'F', 'C' };
+
+/// \returns    The number of bytes \p value took, 7 bits a byte, low first, the top bit set on all but the last.
+size_t WriteNumber( uint8_t* out, uint32_t value )
+{
+    size_t size = 0;
+    while( value >= 0x80 )
+    {
+        out[ size++ ] = static_cast<uint8_t>( value | 0x80 );
+        value >>= 7;
+    }
+    out[ size++ ] = static_cast<uint8_t>( value );
+    return size;
+}
+}  // namespace
+
+const uint16_t CaptureWriter::VERSION;
+const size_t CaptureWriter::HEADER_SIZE;
+const size_t CaptureWriter::MAX_RECORD_HEADER_SIZE;
+
+CaptureWriter::CaptureWriter( Output output ) : output_( output ), lastTime_( 0 ), records_( 0 ) {}
+
+void CaptureWriter::Begin()
+{
+    const uint8_t header[ HEADER_SIZE ] = { MAGIC[ 0 ], MAGIC[ 1 ], MAGIC[ 2 ], MAGIC[ 3 ], static_cast<uint8_t>( VERSION ), static_cast<uint8_t>( VERSION >> 8 ), 0, 0 };
+    output_( header, sizeof( header ) );
+}
+
+void CaptureWriter::Record( CaptureDirection direction, uint32_t time, const uint8_t* data, size_t size )
+{
+    uint8_t header[ MAX_RECORD_HEADER_SIZE ];
+    size_t headerSize = 0;
+    header[ headerSize++ ] = static_cast<uint8_t>( direction );
+    // The first record's time is its own base.
+    headerSize += WriteNumber( &header[ headerSize ], records_ ? time - lastTime_ : 0 );
+    headerSize += WriteNumber( &header[ headerSize ], static_cast<uint32_t>( size ) );
+    output_( header, headerSize );
+    if( size != 0 )
+    {
+        output_( data, size );
+    }
+    lastTime_ = time;
+    ++records_;
+}
+
+CaptureReader::CaptureReader( const uint8_t* capture, size_t size ) : capture_( capture ), size_( size )
+{
+    valid_ = ( size_ >= CaptureWriter::HEADER_SIZE ) && ( capture_[ 0 ] == MAGIC[ 0 ] ) && ( capture_[ 1 ] == MAGIC[ 1 ] ) && ( capture_[ 2 ] == MAGIC[ 2 ] ) &&
+             ( capture_[ 3 ] == MAGIC[ 3 ] ) && ( ( capture_[ 4 ] | ( capture_[ 5 ] << 8 ) ) == CaptureWriter::VERSION );
+    Rewind();
+}
+
+void CaptureReader::Rewind()
+{
+    position_ = CaptureWriter::HEADER_SIZE;
+    time_ = 0;
+    truncated_ = false;
+}
+
+bool CaptureReader::Next( Record& record )
+{
+    if( !valid_ || truncated_ || ( position_ >= size_ ) )
+    {
+        return false;
+    }
+    size_t start = position_;
+    uint8_t direction = capture_[ position_++ ];
+    uint32_t delta;
+    uint32_t size;
+    if( ( direction > static_cast<uint8_t>( CaptureDirection::RX ) ) || !ReadNumber( delta ) || !ReadNumber( size ) || ( size > size_ - position_ ) )
+    {
+        position_ = start;
+        truncated_ = true;
+        return false;
+    }
+    time_ += delta;
+    record.direction = static_cast<CaptureDirection>( direction );
+    record.time = time_;
+    record.data = &capture_[ position_ ];
+    record.size = size;
+    position_ += size;
+    return true;
+}
+
+bool CaptureReader::ReadNumber( uint32_t& value )
+{
+    value = 0;
+    for( uint8_t shift = 0; ( shift < 35 ) && ( position_ < size_ ); shift += 7 )
+    {
+        uint8_t byte = capture_[ position_++ ];
+        value |= static_cast<uint32_t>( byte & 0x7F ) << shift;
+        if( ( byte & 0x80 ) == 0 )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace esf
@@ -10,12 +10,12 @@
 
 namespace esf
 {
-void CobsTranscoder::Encode( const ByteArray& rawData, ByteArray& encodedData )
+void CobsTranscoder::Encode( const IByteArray& rawData, IByteArray& encodedData )
 {
 #if defined( ESF_OPTIMISE )
-    // Pre-size the encoded data container.
+    // Pre-size the encoded data container for the worst case, then trim it to what was used.
     encodedData.resize( 2 + rawData.size() + ( rawData.size() / 254 ) );
-    Encode( rawData.data(), rawData.size(), encodedData.data() );
+    encodedData.resize( Encode( rawData.data(), rawData.size(), encodedData.data() ) );
 #else
     size_t startOfCurrBlock = 0;
     uint8_t numElementsInCurrBlock = 0;
@@ -75,10 +75,11 @@ void CobsTranscoder::Encode( const ByteArray& rawData, ByteArray& encodedData )
     // Insert pointer to the terminating 0x00 character
     encodedData[ startOfCurrBlock ] = numElementsInCurrBlock + 1;
     *encodedIter = 0;
+    encodedData.resize( encodedDataSize + 1 );
 #endif
 }
 
-void CobsTranscoder::Encode( const uint8_t* rawData, size_t length, uint8_t* encodedData )
+size_t CobsTranscoder::Encode( const uint8_t* rawData, size_t length, uint8_t* encodedData )
 {
     size_t startOfBlock = 0;
     uint8_t elementsInBlock = 0;
@@ -124,16 +125,34 @@ void CobsTranscoder::Encode( const uint8_t* rawData, size_t length, uint8_t* enc
     encodedData[ startOfBlock ] = elementsInBlock + 1;
     // ...and terminate.
     encodedData[ encodedDataSize ] = 0;
+    return encodedDataSize + 1;
 }
 
-StatusCode CobsTranscoder::Decode( const ByteArray& encodedData, ByteArray& decodedData )
+StatusCode CobsTranscoder::Decode( const IByteArray& encodedData, IByteArray& decodedData )
 {
 #if defined( ESF_OPTIMISE )
     StatusCode result = StatusCode::ERROR_NOT_ENOUGH_BYTES;
     if( encodedData.size() >= ESF_MIN_BYTES )
     {
-        // Pre-size the decoded data container.
-        decodedData.resize( encodedData.size() - 2 - ( encodedData.size() - 2 - ( encodedData.size() - 2 ) / 254 ) / 254 );
+        // Pre-size the decoded data container, following the block codes (a zero follows every block but a full or
+        // the last one) as an estimate from the length alone is only right for data without zeros.
+        size_t decodedSize = 0;
+        size_t pos = 0;
+        while( ( pos < encodedData.size() ) && ( encodedData[ pos ] != 0x00 ) )
+        {
+            uint8_t code = encodedData[ pos ];
+            decodedSize += code - 1;
+            pos += code;
+            if( ( code < 0xFF ) && ( pos < encodedData.size() ) && ( encodedData[ pos ] != 0x00 ) )
+            {
+                ++decodedSize;
+            }
+        }
+        if( decodedSize > decodedData.max_size() )
+        {
+            return StatusCode::ERROR_RX_DATA_BUFFER_FULL;
+        }
+        decodedData.resize( decodedSize );
         result = Decode( encodedData.data(), encodedData.size(), decodedData.data() );
     }
     return result;
@@ -216,7 +235,7 @@ StatusCode CobsTranscoder::Decode( const uint8_t* encodedData, size_t length, ui
         // reaching maximum size, not because a 0x00 was found.
         if( elementsInBlock < 0xFE )
         {
-            decodedData[ encodedDataPos ] = 0;
+            decodedData[ decodedDataPos ] = 0;
             ++decodedDataPos;
         }
     }
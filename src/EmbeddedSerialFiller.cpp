@@ -4,8 +4,10 @@
  * \date    15th Apr 2020
  */
 
-#if defined( PROFILE_NO_RTOS )
-#include "EmbeddedSerialFiller_NoRTOS.cpp"
-#else
-#include "EmbeddedSerialFiller_RTOS.cpp"
-#endif
\ No newline at end of file
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+
+namespace esf
+{
+// Nodes with their own Config are built wherever they are used.
+template class BasicEmbeddedSerialFiller<DefaultConfig>;
+}  // namespace esf
@@ -0,0 +1,115 @@
+/**
+ * \file    FragmentAssembler.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/FragmentAssembler.h"
+
+#include <cstring>
+
+#include "EmbeddedSerialFiller/CobsTranscoder.h"
+#include "EmbeddedSerialFiller/Utilities.h"
+
+namespace esf
+{
+FragmentAssembler::FragmentAssembler( uint8_t* buffer, size_t capacity )
+    : buffer_( buffer ), capacity_( buffer ? capacity : 0 ), size_( 0 ), inProgress_( false ), messageId_( 0 ), nextIndex_( 0 ), count_( 0 ), discarded_( 0 )
+{
+}
+
+void FragmentAssembler::Reset()
+{
+    inProgress_ = false;
+    size_ = 0;
+}
+
+FragmentAssembler::Progress FragmentAssembler::Accept( const IByteArray& decodedPacket )
+{
+    // Header and CRC.
+    if( decodedPacket.size() < ( HEADER_SIZE + 2 ) )
+    {
+        return Discard();
+    }
+    uint8_t messageId = decodedPacket[ 1 ];
+    uint16_t index = static_cast<uint16_t>( ( decodedPacket[ 2 ] << 8 ) | decodedPacket[ 3 ] );
+    uint16_t count = static_cast<uint16_t>( ( decodedPacket[ 4 ] << 8 ) | decodedPacket[ 5 ] );
+    size_t lengthOfTopic = decodedPacket[ 6 ];
+    if( ( count == 0 ) || ( index >= count ) || ( lengthOfTopic > ESF_MAX_TOPIC_LENGTH ) ||
+        ( lengthOfTopic > decodedPacket.size() - HEADER_SIZE - 2 ) )
+    {
+        return Discard();
+    }
+    const uint8_t* topic = decodedPacket.data() + HEADER_SIZE;
+    const uint8_t* data = topic + lengthOfTopic;
+    size_t size = decodedPacket.size() - HEADER_SIZE - lengthOfTopic - 2;
+
+    if( index == 0 )
+    {
+        if( inProgress_ )
+        {
+            // The rest of the previous message was lost.
+            ++discarded_;
+        }
+        inProgress_ = true;
+        messageId_ = messageId;
+        count_ = count;
+        nextIndex_ = 0;
+        size_ = 0;
+        topic_.assign( topic, topic + lengthOfTopic );
+    }
+    else if( !inProgress_ || ( messageId != messageId_ ) || ( index != nextIndex_ ) || ( count != count_ ) )
+    {
+        return Discard();
+    }
+
+    if( size > ( capacity_ - size_ ) )
+    {
+        return Discard();
+    }
+    if( size )
+    {
+        memcpy( buffer_ + size_, data, size );
+    }
+    size_ += size;
+    ++nextIndex_;
+
+    if( nextIndex_ == count_ )
+    {
+        inProgress_ = false;
+        return Progress::COMPLETE;
+    }
+    return Progress::INCOMPLETE;
+}
+
+FragmentAssembler::Progress FragmentAssembler::Discard()
+{
+    inProgress_ = false;
+    size_ = 0;
+    ++discarded_;
+    return Progress::DISCARDED;
+}
+
+void FragmentAssembler::EncodeFragment( uint8_t messageId, uint16_t index, uint16_t count, const Topic& topic, const uint8_t* data, size_t size, size_t fragmentSize,
+                                        IByteArray& packet, IByteArray& encodedData )
+{
+    size_t offset = static_cast<size_t>( index ) * fragmentSize;
+    size_t length = ( size - offset ) < fragmentSize ? ( size - offset ) : fragmentSize;
+
+    packet.clear();
+    packet.emplace_back( static_cast<uint8_t>( PacketType::FRAGMENT ) );
+    packet.emplace_back( messageId );
+    // Index and count, MSB first.
+    packet.emplace_back( static_cast<uint8_t>( ( index >> 8 ) & 0xFF ) );
+    packet.emplace_back( static_cast<uint8_t>( ( index >> 0 ) & 0xFF ) );
+    packet.emplace_back( static_cast<uint8_t>( ( count >> 8 ) & 0xFF ) );
+    packet.emplace_back( static_cast<uint8_t>( ( count >> 0 ) & 0xFF ) );
+    packet.emplace_back( static_cast<uint8_t>( topic.size() ) );
+    packet.insert( packet.end(), topic.begin(), topic.end() );
+    packet.insert( packet.end(), data + offset, data + offset + length );
+
+    Utilities::AddCrc( packet );
+    CobsTranscoder::Encode( packet, encodedData );
+}
+
+}  // namespace esf
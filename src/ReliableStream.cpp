@@ -0,0 +1,13 @@
+/**
+ * \file    ReliableStream.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/ReliableStream.h"
+
+namespace esf
+{
+// Streams for other packet sizes are built wherever they are used.
+template class BasicReliableStream<ESF_MAX_PACKET_SIZE>;
+}  // namespace esf
@@ -0,0 +1,56 @@
+/**
+ * \file    RttEstimator.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/RttEstimator.h"
+
+namespace esf
+{
+RttEstimator::RttEstimator( uint32_t initialRto, uint32_t minRto, uint32_t maxRto )
+{
+    Reset( initialRto, minRto, maxRto );
+}
+
+void RttEstimator::Reset( uint32_t initialRto, uint32_t minRto, uint32_t maxRto )
+{
+    srtt8_ = 0;
+    rttvar4_ = 0;
+    minRto_ = minRto;
+    maxRto_ = ( maxRto < minRto ) ? minRto : maxRto;
+    rto_ = ( initialRto < minRto_ ) ? minRto_ : ( ( initialRto > maxRto_ ) ? maxRto_ : initialRto );
+    samples_ = 0;
+}
+
+void RttEstimator::AddSample( uint32_t rtt )
+{
+    if( samples_ == 0 )
+    {
+        // SRTT = R, RTTVAR = R / 2
+        srtt8_ = rtt << 3;
+        rttvar4_ = rtt << 1;
+    }
+    else
+    {
+        int32_t delta = static_cast<int32_t>( rtt ) - static_cast<int32_t>( srtt8_ >> 3 );
+        srtt8_ = static_cast<uint32_t>( static_cast<int32_t>( srtt8_ ) + delta );
+        if( delta < 0 )
+        {
+            delta = -delta;
+        }
+        rttvar4_ = static_cast<uint32_t>( static_cast<int32_t>( rttvar4_ ) + delta - static_cast<int32_t>( rttvar4_ >> 2 ) );
+    }
+    ++samples_;
+
+    // RTO = SRTT + 4 * RTTVAR, the variance term being at least 1 unit.
+    uint32_t rto = ( srtt8_ >> 3 ) + ( rttvar4_ ? rttvar4_ : 1 );
+    rto_ = ( rto < minRto_ ) ? minRto_ : ( ( rto > maxRto_ ) ? maxRto_ : rto );
+}
+
+uint32_t RttEstimator::Backoff( uint32_t rto ) const
+{
+    return ( rto >= ( maxRto_ >> 1 ) ) ? maxRto_ : ( rto << 1 );
+}
+
+}  // namespace esf
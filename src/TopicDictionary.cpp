@@ -0,0 +1,110 @@
+/**
+ * \file    TopicDictionary.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/TopicDictionary.h"
+
+namespace esf
+{
+const uint8_t TopicDictionary::TOPIC_ID_FLAG;
+
+TopicDictionary::TopicDictionary()
+{
+    Reset();
+}
+
+void TopicDictionary::Reset()
+{
+    for( size_t i = 0; i < ESF_MAX_TOPIC_IDS; ++i )
+    {
+        tx_[ i ].state = TxState::UNUSED;
+        tx_[ i ].uses = 0;
+        tx_[ i ].topic.clear();
+        rx_[ i ].known = false;
+        rx_[ i ].topic.clear();
+    }
+}
+
+TopicDictionary::TxAction TopicDictionary::TxLookup( const Topic& topic, uint8_t& topicId )
+{
+    size_t unused = ESF_MAX_TOPIC_IDS;
+    for( size_t i = 0; i < ESF_MAX_TOPIC_IDS; ++i )
+    {
+        TxEntry& entry = tx_[ i ];
+        if( entry.state == TxState::UNUSED )
+        {
+            if( unused == ESF_MAX_TOPIC_IDS )
+            {
+                unused = i;
+            }
+        }
+        else if( entry.topic == topic )
+        {
+            topicId = static_cast<uint8_t>( i );
+            if( entry.state == TxState::CONFIRMED )
+            {
+                return TxAction::SEND_ID;
+            }
+            // The announcement (or its acknowledge) may have been lost, so repeat it now and again.
+            if( ++entry.uses >= ESF_TOPIC_ANNOUNCE_RETRY )
+            {
+                entry.uses = 0;
+                return TxAction::ANNOUNCE;
+            }
+            return TxAction::SEND_STRING;
+        }
+    }
+
+    if( unused == ESF_MAX_TOPIC_IDS )
+    {
+        // Dictionary full.
+        return TxAction::SEND_STRING;
+    }
+    TxEntry& entry = tx_[ unused ];
+    entry.state = TxState::ANNOUNCED;
+    entry.uses = 0;
+    entry.topic = topic;
+    topicId = static_cast<uint8_t>( unused );
+    return TxAction::ANNOUNCE;
+}
+
+void TopicDictionary::TxConfirm( uint8_t topicId )
+{
+    if( ( topicId < ESF_MAX_TOPIC_IDS ) && ( tx_[ topicId ].state == TxState::ANNOUNCED ) )
+    {
+        tx_[ topicId ].state = TxState::CONFIRMED;
+    }
+}
+
+void TopicDictionary::TxReject( uint8_t topicId )
+{
+    if( ( topicId < ESF_MAX_TOPIC_IDS ) && ( tx_[ topicId ].state != TxState::UNUSED ) )
+    {
+        tx_[ topicId ].state = TxState::ANNOUNCED;
+        tx_[ topicId ].uses = ESF_TOPIC_ANNOUNCE_RETRY;
+    }
+}
+
+bool TopicDictionary::RxLearn( uint8_t topicId, const Topic& topic )
+{
+    if( topicId >= ESF_MAX_TOPIC_IDS )
+    {
+        return false;
+    }
+    rx_[ topicId ].known = true;
+    rx_[ topicId ].topic = topic;
+    return true;
+}
+
+const Topic* TopicDictionary::RxResolve( uint8_t topicId ) const
+{
+    if( ( topicId < ESF_MAX_TOPIC_IDS ) && rx_[ topicId ].known )
+    {
+        return &rx_[ topicId ].topic;
+    }
+    return nullptr;
+}
+
+}  // namespace esf
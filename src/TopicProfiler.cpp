@@ -0,0 +1,117 @@
+/**
+ * \file    TopicProfiler.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/TopicProfiler.h"
+
+namespace esf
+{
+uint32_t TopicProfiler::Profile::Percentile( uint32_t percent ) const
+{
+    uint32_t calls = 0;
+    for( size_t i = 0; i < BUCKETS; ++i )
+    {
+        calls += histogram[ i ];
+    }
+    // The smallest bucket whose count, with those below it, reaches percent of the calls.
+    uint32_t wanted = static_cast<uint32_t>( ( static_cast<uint64_t>( calls ) * percent + 99 ) / 100 );
+    uint32_t seen = 0;
+    for( size_t i = 0; i < BUCKETS - 1; ++i )
+    {
+        seen += histogram[ i ];
+        if( seen >= wanted )
+        {
+            // The bucket's largest time, or the longest time seen if that is smaller.
+            uint32_t upper = ( 1u << i ) - 1;
+            return upper < maxTicks ? upper : maxTicks;
+        }
+    }
+    return maxTicks;
+}
+
+TopicProfiler::TopicProfiler()
+{
+    Reset();
+}
+
+void TopicProfiler::Reset()
+{
+    // Each profile is cleared as it is taken for a topic.
+    topics_ = 0;
+    first_ = 0;
+    last_ = 0;
+    overflows_ = 0;
+}
+
+TopicProfiler::Profile* TopicProfiler::Message( const Topic& topic, size_t size, uint32_t now )
+{
+    first_ = ( ( topics_ == 0 ) && ( overflows_ == 0 ) ) ? now : first_;
+    last_ = now;
+
+    Profile* profile = nullptr;
+    for( size_t i = 0; i < topics_; ++i )
+    {
+        if( profiles_[ i ].topic == topic )
+        {
+            profile = &profiles_[ i ];
+            break;
+        }
+    }
+    if( profile == nullptr )
+    {
+        if( topics_ == ESF_PROFILER_TOPICS )
+        {
+            ++overflows_;
+            return nullptr;
+        }
+        profile = &profiles_[ topics_++ ];
+        *profile = Profile();
+        profile->topic = topic;
+    }
+    ++profile->messages;
+    profile->bytes += static_cast<uint32_t>( size );
+    return profile;
+}
+
+void TopicProfiler::Callback( Profile& profile, uint32_t ticks )
+{
+    ++profile.deliveries;
+    profile.ticks += ticks;
+    profile.maxTicks = ticks > profile.maxTicks ? ticks : profile.maxTicks;
+    size_t bucket = 0;
+    while( ( ticks != 0 ) && ( bucket < BUCKETS - 1 ) )
+    {
+        ticks >>= 1;
+        ++bucket;
+    }
+    ++profile.histogram[ bucket ];
+}
+
+size_t TopicProfiler::Hottest( const Profile* hottest[], size_t count ) const
+{
+    size_t found = 0;
+    for( size_t i = 0; i < topics_; ++i )
+    {
+        // Insert into those found so far, which are kept in order, dropping the coolest once there are count.
+        const Profile* profile = &profiles_[ i ];
+        size_t at = found;
+        while( ( at > 0 ) && ( hottest[ at - 1 ]->ticks < profile->ticks ) )
+        {
+            --at;
+        }
+        if( at < count )
+        {
+            for( size_t j = ( found < count ) ? found : count - 1; j > at; --j )
+            {
+                hottest[ j ] = hottest[ j - 1 ];
+            }
+            hottest[ at ] = profile;
+            found = ( found < count ) ? found + 1 : count;
+        }
+    }
+    return found;
+}
+
+}  // namespace esf
@@ -12,7 +12,55 @@
 
 namespace esf
 {
-StatusCode Utilities::MoveRxDataInBuffer( ByteArray& newRxData, ByteArray& rxDataBuffer, ByteArray& packet )
+namespace
+{
+/// \brief      CRC16-CCITT (polynomial 0x1021) a byte at a time, for VerifyCrcs().
+const uint16_t CRC_TABLE[ 256 ] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
+
+/// \brief      Packets VerifyCrcs() checks side by side.
+const size_t CRC_LANES = 4;
+
+inline uint16_t AddCrcByte( uint16_t crc, uint8_t byte )
+{
+    return static_cast<uint16_t>( ( crc << 8 ) ^ CRC_TABLE[ ( crc >> 8 ) ^ byte ] );
+}
+
+}  // namespace
+
+StatusCode Utilities::MoveRxDataInBuffer( IByteArray& newRxData, IByteArray& rxDataBuffer, IByteArray& packet )
 {
     StatusCode retVal = StatusCode::SUCCESS;
     // Clear any existing data from packet
@@ -39,8 +87,8 @@ StatusCode Utilities::MoveRxDataInBuffer( ByteArray& newRxData, ByteArray& rxDat
             // Found end-of-packet!
             // Move everything from the start to byteOfData from rxData into a new packet
 #if defined( ESF_OPTIMISE )
-            ByteArray::const_iterator iter = rxDataBuffer.begin();
-            ByteArray::const_iterator endIter = rxDataBuffer.end();
+            IByteArray::const_iterator iter = rxDataBuffer.begin();
+            IByteArray::const_iterator endIter = rxDataBuffer.end();
             for( ; iter < endIter; ++iter )
             {
                 packet.emplace_back( *iter );
@@ -56,7 +104,7 @@ StatusCode Utilities::MoveRxDataInBuffer( ByteArray& newRxData, ByteArray& rxDat
             }
             else
             {
-                newRxData = ByteArray( newRxData.begin() + idx, newRxData.end() );
+                newRxData.erase( newRxData.begin(), newRxData.begin() + idx );
             }
             return retVal;
         }
@@ -69,7 +117,7 @@ StatusCode Utilities::MoveRxDataInBuffer( ByteArray& newRxData, ByteArray& rxDat
     return retVal;
 }
 
-void Utilities::AddCrc( ByteArray& packet )
+void Utilities::AddCrc( IByteArray& packet )
 {
     uint16_t crcVal = etl::crc16_ccitt( packet.begin(), packet.end() );
 
@@ -78,7 +126,7 @@ void Utilities::AddCrc( ByteArray& packet )
     packet.emplace_back( static_cast<uint8_t>( ( crcVal >> 0 ) & 0xFF ) );
 }
 
-StatusCode Utilities::VerifyCrc( const ByteArray& packet )
+StatusCode Utilities::VerifyCrc( const IByteArray& packet )
 {
     if( packet.size() < ESF_MIN_BYTES )
     {
@@ -101,7 +149,74 @@ StatusCode Utilities::VerifyCrc( const ByteArray& packet )
     return StatusCode::SUCCESS;
 }
 
-StatusCode Utilities::SplitPacket( const ByteArray& packet, uint32_t startAt, Topic& topic, ByteArray& data )
+uint32_t Utilities::VerifyCrcs( const IByteArray* const packets[], size_t count )
+{
+    // The mask has a bit for only the first 32, the rest are never checked (and so fail).
+    const size_t MAX_PACKETS = 32;
+    if( count > MAX_PACKETS )
+    {
+        count = MAX_PACKETS;
+    }
+    // Only packets long enough to hold a CRC are checked, so a short one doesn't hold up the others in its lane group.
+    size_t index[ MAX_PACKETS ];
+    size_t checked = 0;
+    for( size_t i = 0; i < count; ++i )
+    {
+        if( packets[ i ]->size() >= ESF_MIN_BYTES )
+        {
+            index[ checked++ ] = i;
+        }
+    }
+
+    uint32_t passed = 0;
+    for( size_t first = 0; first < checked; first += CRC_LANES )
+    {
+        size_t lanes = ( checked - first < CRC_LANES ) ? checked - first : CRC_LANES;
+        const uint8_t* data[ CRC_LANES ];
+        size_t length[ CRC_LANES ];
+        uint16_t crc[ CRC_LANES ] = { 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF };
+        size_t common = SIZE_MAX;
+        for( size_t lane = 0; lane < lanes; ++lane )
+        {
+            const IByteArray& packet = *packets[ index[ first + lane ] ];
+            data[ lane ] = packet.data();
+            length[ lane ] = packet.size() - 2;
+            common = ( length[ lane ] < common ) ? length[ lane ] : common;
+        }
+
+        // The bytes all four have, a byte of each in turn. Each CRC depends only on its own last value, so the four
+        // chains overlap rather than each waiting on the table lookup before it.
+        size_t i = 0;
+        if( lanes == CRC_LANES )
+        {
+            for( ; i < common; ++i )
+            {
+                crc[ 0 ] = AddCrcByte( crc[ 0 ], data[ 0 ][ i ] );
+                crc[ 1 ] = AddCrcByte( crc[ 1 ], data[ 1 ][ i ] );
+                crc[ 2 ] = AddCrcByte( crc[ 2 ], data[ 2 ][ i ] );
+                crc[ 3 ] = AddCrcByte( crc[ 3 ], data[ 3 ][ i ] );
+            }
+        }
+
+        // What's left of each, on its own.
+        for( size_t lane = 0; lane < lanes; ++lane )
+        {
+            const uint8_t* bytes = data[ lane ];
+            for( size_t j = i; j < length[ lane ]; ++j )
+            {
+                crc[ lane ] = AddCrcByte( crc[ lane ], bytes[ j ] );
+            }
+            uint16_t sentCrcVal = static_cast<uint16_t>( ( bytes[ length[ lane ] ] << 8 ) | bytes[ length[ lane ] + 1 ] );
+            if( sentCrcVal == crc[ lane ] )
+            {
+                passed |= 1u << index[ first + lane ];
+            }
+        }
+    }
+    return passed;
+}
+
+StatusCode Utilities::SplitPacket( const IByteArray& packet, uint32_t startAt, Topic& topic, IByteArray& data )
 {
     // Get length of topic
     assert( startAt < packet.size() );
@@ -147,6 +262,18 @@ const char* Utilities::StatusCodeToString( StatusCode statusCode )
             return "ERROR_ZERO_BYTE_NOT_EXPECTED";
         case StatusCode::ERROR_RX_DATA_BUFFER_FULL:
             return "ERROR_RX_DATA_BUFFER_FULL";
+        case StatusCode::ERROR_STREAM_NOT_ATTACHED:
+            return "ERROR_STREAM_NOT_ATTACHED";
+        case StatusCode::ERROR_STREAM_WINDOW_FULL:
+            return "ERROR_STREAM_WINDOW_FULL";
+        case StatusCode::ERROR_ASSEMBLER_NOT_ATTACHED:
+            return "ERROR_ASSEMBLER_NOT_ATTACHED";
+        case StatusCode::ERROR_MESSAGE_TOO_LARGE:
+            return "ERROR_MESSAGE_TOO_LARGE";
+        case StatusCode::ERROR_UNKNOWN_TOPIC_ID:
+            return "ERROR_UNKNOWN_TOPIC_ID";
+        case StatusCode::ERROR_NO_FREE_FRAMES:
+            return "ERROR_NO_FREE_FRAMES";
 #if defined( ESF_REJECT_INCOMPLETE_PACKETS )
         case StatusCode::ERROR_PACKET_INCOMPLETE:
             return "ERROR_PACKET_INCOMPLETE";
@@ -0,0 +1,163 @@
+/**
+ * \file    AckAggregationTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include <thread>
+
+#include "EmbeddedSerialFiller/CobsTranscoder.h"
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "EmbeddedSerialFiller/Utilities.h"
+#include "TwoNodeFixture.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+static ByteArray savedData;
+auto dataStore = []( ByteArray& data ) { savedData = data; };
+
+const uint32_t ACK_DELAY = 5;
+
+class AckAggregationTests : public esf_test::TwoNodeFixture
+{
+   protected:
+    AckAggregationTests()
+    {
+        savedData.clear();
+        node2_.SetAckDelay( ACK_DELAY );
+    }
+
+    // Sends a PUBLISH from node 1 without waiting for its acknowledge.
+    uint8_t SendPublish()
+    {
+        uint8_t packetId = node1_.NextPacketID();
+        node1_.PublishWait( "topic", { packetId }, 0 );
+        return packetId;
+    }
+
+    virtual ~AckAggregationTests() {}
+};
+
+TEST_F( AckAggregationTests, AdvanceSkipsZero )
+{
+    EXPECT_EQ( 2, AckAggregator::Advance( 1, 1 ) );
+    EXPECT_EQ( 1, AckAggregator::Advance( 255, 1 ) );
+    EXPECT_EQ( 3, AckAggregator::Advance( 254, 4 ) );
+    EXPECT_TRUE( AckAggregator::Contains( 254, 0x0004, 2 ) );
+    EXPECT_FALSE( AckAggregator::Contains( 254, 0x0004, 1 ) );
+}
+
+TEST_F( AckAggregationTests, BlockSpansPacketIdWrap )
+{
+    AckAggregator acks;
+    acks.SetDelay( ACK_DELAY );
+    EXPECT_TRUE( acks.Add( 254 ) );
+    EXPECT_TRUE( acks.Add( 255 ) );
+    EXPECT_TRUE( acks.Add( 2 ) );
+    // 17 IDs after the base is too far.
+    EXPECT_FALSE( acks.Add( AckAggregator::Advance( 254, 17 ) ) );
+
+    uint8_t base;
+    uint16_t bitmap;
+    acks.Take( base, bitmap );
+    EXPECT_EQ( 254, base );
+    EXPECT_EQ( 0x0005, bitmap );
+    EXPECT_FALSE( acks.Pending() );
+}
+
+TEST_F( AckAggregationTests, AcksAreHeldBackAndSentTogether )
+{
+    uint8_t firstId = SendPublish();
+    SendPublish();
+    SendPublish();
+    ASSERT_EQ( 3u, Pending( toNode2_ ) );
+    while( Pending( toNode2_ ) )
+    {
+        ByteArray frame = Pop( toNode2_ );
+        node2_.GiveRxData( frame );
+    }
+    EXPECT_EQ( 0u, Pending( toNode1_ ) );
+
+    node2_.Poll( ACK_DELAY - 1 );
+    EXPECT_EQ( 0u, Pending( toNode1_ ) );
+
+    node2_.Poll( 1 );
+    ASSERT_EQ( 1u, Pending( toNode1_ ) );
+    ByteArray decoded = Decode( Pop( toNode1_ ) );
+    ASSERT_EQ( 6u, decoded.size() );
+    EXPECT_EQ( static_cast<uint8_t>( PacketType::ACK_BITMAP ), decoded[ 0 ] );
+    EXPECT_EQ( firstId, decoded[ 1 ] );
+    EXPECT_EQ( 0x00, decoded[ 2 ] );
+    EXPECT_EQ( 0x03, decoded[ 3 ] );
+}
+
+TEST_F( AckAggregationTests, AcksRideAlongWithData )
+{
+    node1_.Subscribe( "reply", etl::delegate<void( ByteArray & data )>( dataStore ) );
+    SendPublish();
+    SendPublish();
+    while( Pending( toNode2_ ) )
+    {
+        ByteArray frame = Pop( toNode2_ );
+        node2_.GiveRxData( frame );
+    }
+
+    node2_.Publish( "reply", { 'o', 'k' } );
+    ASSERT_EQ( 1u, Pending( toNode1_ ) );
+    ByteArray frame = Pop( toNode1_ );
+    EXPECT_EQ( static_cast<uint8_t>( PacketType::BROADCAST_ACKS ), Decode( frame )[ 0 ] );
+
+    // Nothing left to send once the delay expires.
+    node2_.Poll( ACK_DELAY );
+    EXPECT_EQ( 0u, Pending( toNode1_ ) );
+
+    EXPECT_EQ( StatusCode::SUCCESS, node1_.GiveRxData( frame ) );
+    EXPECT_EQ( ByteArray( { 'o', 'k' } ), savedData );
+}
+
+TEST_F( AckAggregationTests, BitmapCompletesPublishWait )
+{
+    PublishResponse result = PublishResponse::UNKNOWN;
+    std::thread t1( [ & ]() { result = node1_.PublishWait( "topic", { 0x01 }, 1000 ); } );
+
+    while( Pending( toNode2_ ) == 0 )
+    {
+        std::this_thread::yield();
+    }
+    ByteArray frame = Pop( toNode2_ );
+    node2_.GiveRxData( frame );
+    node2_.Poll( ACK_DELAY );
+    ASSERT_EQ( 1u, Pending( toNode1_ ) );
+    frame = Pop( toNode1_ );
+    EXPECT_EQ( StatusCode::SUCCESS, node1_.GiveRxData( frame ) );
+
+    t1.join();
+    EXPECT_TRUE( result == PublishResponse::SUCCESS );
+}
+
+TEST_F( AckAggregationTests, BadAcksDontLoseTheRestOfTheChunk )
+{
+    node1_.Subscribe( "reply", etl::delegate<void( ByteArray & data )>( dataStore ) );
+    node2_.Publish( "reply", { 'o', 'k' } );
+    ByteArray reply = Pop( toNode1_ );
+
+    // An ACK nobody waits for, and a BROADCAST_ACKS too short to hold its acknowledges.
+    ByteArray chunk;
+    for( const ByteArray& packet : { ByteArray( { static_cast<uint8_t>( PacketType::ACK ), 0x33 } ), ByteArray( { static_cast<uint8_t>( PacketType::BROADCAST_ACKS ), 0x01, 0x01 } ) } )
+    {
+        ByteArray withCrc( packet );
+        Utilities::AddCrc( withCrc );
+        ByteArray frame;
+        CobsTranscoder::Encode( withCrc, frame );
+        chunk.insert( chunk.end(), frame.begin(), frame.end() );
+    }
+    chunk.insert( chunk.end(), reply.begin(), reply.end() );
+
+    EXPECT_EQ( StatusCode::ERROR_NOT_ENOUGH_BYTES, node1_.GiveRxData( chunk ) );
+    EXPECT_EQ( ByteArray( { 'o', 'k' } ), savedData );
+}
+
+}  // namespace
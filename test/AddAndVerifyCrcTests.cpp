@@ -4,6 +4,8 @@
  * \date    11 Sep 2019
  */
 
+#include <vector>
+
 #include "EmbeddedSerialFiller/Utilities.h"
 #include "gtest/gtest.h"
 
@@ -41,4 +43,47 @@ TEST_F( AddAndVerifyCrcTests, BadCrcTest )
     EXPECT_EQ( StatusCode::ERROR_CRC_CHECK_FAILED, Utilities::VerifyCrc( ByteArray( { 0x01, 0x02, 0x03, 0xAD, 0xAE } ) ) );
 }
 
+TEST_F( AddAndVerifyCrcTests, BatchTest )
+{
+    // Sizes from too short to hold a CRC to past any common length, every third with a byte flipped.
+    std::vector<ByteArray> packets( 19 );
+    const IByteArray* pointers[ 19 ];
+    uint32_t expected = 0;
+    for( size_t i = 0; i < packets.size(); ++i )
+    {
+        for( size_t j = 0; j < ( i * 7 ) % 40; ++j )
+        {
+            packets[ i ].push_back( static_cast<uint8_t>( i * 31 + j ) );
+        }
+        if( i % 4 != 1 )
+        {
+            Utilities::AddCrc( packets[ i ] );
+        }
+        if( ( i % 3 == 0 ) && !packets[ i ].empty() )
+        {
+            packets[ i ][ i % packets[ i ].size() ] ^= 0x04;
+        }
+        pointers[ i ] = &packets[ i ];
+        expected |= ( Utilities::VerifyCrc( packets[ i ] ) == StatusCode::SUCCESS ) ? 1u << i : 0u;
+    }
+    EXPECT_NE( 0u, expected );
+    EXPECT_EQ( expected, Utilities::VerifyCrcs( pointers, packets.size() ) );
+    // Fewer than four, and none.
+    EXPECT_EQ( expected & 0x7u, Utilities::VerifyCrcs( pointers, 3 ) );
+    EXPECT_EQ( 0u, Utilities::VerifyCrcs( pointers, 0 ) );
+}
+
+TEST_F( AddAndVerifyCrcTests, BatchPastMaskTest )
+{
+    // More packets than the mask has bits for, all good. Only the first 32 are checked.
+    ByteArray packet( { 0x01, 0x02, 0x03 } );
+    Utilities::AddCrc( packet );
+    const IByteArray* pointers[ 40 ];
+    for( size_t i = 0; i < 40; ++i )
+    {
+        pointers[ i ] = &packet;
+    }
+    EXPECT_EQ( 0xFFFFFFFFu, Utilities::VerifyCrcs( pointers, 40 ) );
+}
+
 }  // namespace
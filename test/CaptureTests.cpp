@@ -0,0 +1,129 @@
+/**
+ * \file    CaptureTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include <vector>
+
+#include "EmbeddedSerialFiller/Capture.h"
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+class CaptureTests : public ::testing::Test
+{
+   public:
+    void Output( const uint8_t* data, size_t size ) { capture_.insert( capture_.end(), data, data + size ); }
+    uint32_t Clock() { return time_; }
+    void Node1Tx( const ByteArray& data ) { node1Tx_ = data; }
+    void OnData( ByteArray& data ) { received_.push_back( data ); }
+
+   protected:
+    CaptureTests() : writer_( CaptureWriter::Output::create<CaptureTests, &CaptureTests::Output>( *this ) ), time_( 0 ) {}
+
+    virtual ~CaptureTests() {}
+
+    std::vector<uint8_t> capture_;
+    CaptureWriter writer_;
+    uint32_t time_;
+    ByteArray node1Tx_;
+    std::vector<ByteArray> received_;
+};
+
+TEST_F( CaptureTests, RoundTrip )
+{
+    const uint8_t frame[] = { 0x03, 0x42, 0x01, 0x00 };
+    const std::vector<uint8_t> chunk( 300, 0x5A );
+    writer_.Begin();
+    writer_.Record( CaptureDirection::TX, 0xFFFFFF00u, frame, sizeof( frame ) );
+    // Across the 32 bit wrap.
+    writer_.Record( CaptureDirection::RX, 0x00000100u, chunk.data(), chunk.size() );
+    writer_.Record( CaptureDirection::RX, 0x00000100u, nullptr, 0 );
+    EXPECT_EQ( 3u, writer_.Records() );
+    // Header, then the direction and LEB128 time and size of each record: 300 takes two bytes.
+    EXPECT_EQ( CaptureWriter::HEADER_SIZE + ( 3 + sizeof( frame ) ) + ( 1 + 2 + 2 + chunk.size() ) + 3, capture_.size() );
+
+    CaptureReader reader( capture_.data(), capture_.size() );
+    ASSERT_TRUE( reader.Valid() );
+    CaptureReader::Record record;
+    ASSERT_TRUE( reader.Next( record ) );
+    EXPECT_EQ( CaptureDirection::TX, record.direction );
+    EXPECT_EQ( 0u, record.time );
+    EXPECT_EQ( std::vector<uint8_t>( frame, frame + sizeof( frame ) ), std::vector<uint8_t>( record.data, record.data + record.size ) );
+    ASSERT_TRUE( reader.Next( record ) );
+    EXPECT_EQ( CaptureDirection::RX, record.direction );
+    EXPECT_EQ( 0x200u, record.time );
+    EXPECT_EQ( chunk, std::vector<uint8_t>( record.data, record.data + record.size ) );
+    ASSERT_TRUE( reader.Next( record ) );
+    EXPECT_EQ( 0u, record.size );
+    EXPECT_FALSE( reader.Next( record ) );
+    EXPECT_FALSE( reader.Truncated() );
+
+    reader.Rewind();
+    ASSERT_TRUE( reader.Next( record ) );
+    EXPECT_EQ( CaptureDirection::TX, record.direction );
+}
+
+TEST_F( CaptureTests, Truncated )
+{
+    const uint8_t frame[] = { 0x03, 0x42, 0x01, 0x00 };
+    writer_.Begin();
+    writer_.Record( CaptureDirection::TX, 0, frame, sizeof( frame ) );
+    writer_.Record( CaptureDirection::TX, 10, frame, sizeof( frame ) );
+    capture_.pop_back();
+
+    CaptureReader reader( capture_.data(), capture_.size() );
+    CaptureReader::Record record;
+    EXPECT_TRUE( reader.Next( record ) );
+    EXPECT_FALSE( reader.Next( record ) );
+    EXPECT_TRUE( reader.Truncated() );
+}
+
+TEST_F( CaptureTests, NotACapture )
+{
+    const uint8_t bytes[] = { 'E', 'S', 'F', 'X', 0x01, 0x00, 0x00, 0x00 };
+    CaptureReader reader( bytes, sizeof( bytes ) );
+    CaptureReader::Record record;
+    EXPECT_FALSE( reader.Valid() );
+    EXPECT_FALSE( reader.Next( record ) );
+}
+
+TEST_F( CaptureTests, TapThenReplay )
+{
+    EmbeddedSerialFiller node1;
+    EmbeddedSerialFiller node2;
+    node1.txDataReady_ = etl::delegate<void( const ByteArray& )>::create<CaptureTests, &CaptureTests::Node1Tx>( *this );
+    writer_.Begin();
+    {
+        CaptureTap<EmbeddedSerialFiller> tap( node1, writer_, CaptureTap<EmbeddedSerialFiller>::Clock::create<CaptureTests, &CaptureTests::Clock>( *this ) );
+        time_ = 100;
+        node1.Publish( "topic", { 0x01, 0x02 } );
+        // Still passed on.
+        ASSERT_FALSE( node1Tx_.empty() );
+        time_ = 250;
+        ByteArray rxData( node1Tx_ );
+        tap.GiveRxData( rxData );
+    }
+    EXPECT_EQ( 2u, writer_.Records() );
+
+    // What node1 sent, replayed into node2.
+    node2.Subscribe( "topic", etl::delegate<void( ByteArray& )>::create<CaptureTests, &CaptureTests::OnData>( *this ) );
+    CaptureReader reader( capture_.data(), capture_.size() );
+    CaptureReader::Record record;
+    ASSERT_TRUE( reader.Next( record ) );
+    EXPECT_EQ( CaptureDirection::TX, record.direction );
+    ByteArray rxData( record.data, record.data + record.size );
+    EXPECT_EQ( StatusCode::SUCCESS, node2.GiveRxData( rxData ) );
+    ASSERT_EQ( 1u, received_.size() );
+    EXPECT_EQ( ByteArray( { 0x01, 0x02 } ), received_[ 0 ] );
+
+    ASSERT_TRUE( reader.Next( record ) );
+    EXPECT_EQ( CaptureDirection::RX, record.direction );
+    EXPECT_EQ( 150u, record.time );
+}
+
+}  // namespace
@@ -148,4 +148,23 @@ TEST_F( CobsEncodeDecodeTest, MoreThan254Bytes )
     EXPECT_EQ( rawData, decodedData );
 }
 
+TEST_F( CobsEncodeDecodeTest, MoreThan254BytesWithZeros )
+{
+    // Zeros end blocks early, so the encoded data is no longer than for a single full block.
+    ByteArray rawData;
+    for( int i = 0; i < 300; i++ )
+    {
+        rawData.push_back( ( i % 10 ) == 0 ? 0x00 : 0x01 );
+    }
+
+    ByteArray encodedData;
+    CobsTranscoder::Encode( rawData, encodedData );
+    EXPECT_EQ( 302, encodedData.size() );
+
+    ByteArray decodedData;
+    decodedData.assign( 10, 0xAA );
+    EXPECT_EQ( StatusCode::SUCCESS, CobsTranscoder::Decode( encodedData, decodedData ) );
+    EXPECT_EQ( rawData, decodedData );
+}
+
 }  // namespace
@@ -0,0 +1,213 @@
+/**
+ * \file    ConfigTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include <atomic>
+#include <thread>
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+struct TelemetryConfig : DefaultConfig
+{
+    static const size_t PACKET_SIZE = 32;
+    static const size_t RX_BUFFER_SIZE = 64;
+    static const size_t TOPICS = 2;
+    static const size_t SUBSCRIBERS = 1;
+    static const size_t PENDING_ACKS = 1;
+    static const size_t LATENCY_BITS = 8;
+    static const size_t LATENCY_SUB_BITS = 1;
+};
+typedef BasicEmbeddedSerialFiller<TelemetryConfig> TelemetryNode;
+
+static_assert( sizeof( TelemetryNode ) < sizeof( EmbeddedSerialFiller ) / 4, "Config doesn't size the node" );
+static_assert( TelemetryNode::ByteArray::MAX_SIZE == 32, "" );
+static_assert( sizeof( TelemetryNode::ReliableStream ) < sizeof( ReliableStream ) / 4, "Config doesn't size the stream" );
+
+struct SingleThreadConfig : DefaultConfig
+{
+    typedef NoLock Lock;
+};
+typedef BasicEmbeddedSerialFiller<SingleThreadConfig> SingleThreadNode;
+
+static_assert( sizeof( SingleThreadNode ) < sizeof( EmbeddedSerialFiller ), "NoLock leaves the condition variables behind" );
+
+struct SpinConfig : DefaultConfig
+{
+    typedef SpinLock Lock;
+};
+typedef BasicEmbeddedSerialFiller<SpinConfig> SpinNode;
+
+class ConfigTests : public ::testing::Test
+{
+   public:
+    void SmallToLarge( const TelemetryNode::ByteArray& data ) { large_.GiveRxData( const_cast<TelemetryNode::ByteArray&>( data ) ); }
+    void LargeToSmall( const ByteArray& data ) { small_.GiveRxData( const_cast<ByteArray&>( data ) ); }
+    void CaptureSmall( const TelemetryNode::ByteArray& data ) { smallFrame_ = data; }
+    void CaptureLarge( const ByteArray& data ) { largeFrame_ = data; }
+
+    void OnSmall( TelemetryNode::ByteArray& data )
+    {
+        received_ = data;
+        ++calls_;
+    }
+    void OnLarge( ByteArray& ) { ++calls_; }
+
+   protected:
+    TelemetryNode small_;
+    EmbeddedSerialFiller large_;
+    TelemetryNode::ByteArray received_;
+    TelemetryNode::ByteArray smallFrame_;
+    ByteArray largeFrame_;
+    int calls_;
+
+    ConfigTests() : calls_( 0 )
+    {
+        small_.txDataReady_ = etl::delegate<void( const TelemetryNode::ByteArray& )>::create<ConfigTests, &ConfigTests::SmallToLarge>( *this );
+        large_.txDataReady_ = etl::delegate<void( const ByteArray& )>::create<ConfigTests, &ConfigTests::LargeToSmall>( *this );
+    }
+
+    virtual ~ConfigTests() {}
+};
+
+TEST_F( ConfigTests, NodesOfDifferentSizesInteroperate )
+{
+    small_.Subscribe( "temp", etl::delegate<void( TelemetryNode::ByteArray& )>::create<ConfigTests, &ConfigTests::OnSmall>( *this ) );
+    large_.Subscribe( "temp", etl::delegate<void( ByteArray& )>::create<ConfigTests, &ConfigTests::OnLarge>( *this ) );
+
+    large_.Publish( "temp", { 0x01, 0x00, 0x02 } );
+    EXPECT_EQ( 1, calls_ );
+    EXPECT_EQ( TelemetryNode::ByteArray( { 0x01, 0x00, 0x02 } ), received_ );
+
+    small_.Publish( "temp", { 0x03 } );
+    EXPECT_EQ( 2, calls_ );
+}
+
+TEST_F( ConfigTests, CapacitiesApply )
+{
+    auto callback = etl::delegate<void( TelemetryNode::ByteArray& )>::create<ConfigTests, &ConfigTests::OnSmall>( *this );
+    EXPECT_NE( TelemetryNode::TopicTable::INVALID_ID, small_.Subscribe( "a", callback ) );
+    EXPECT_EQ( TelemetryNode::TopicTable::INVALID_ID, small_.Subscribe( "a", callback ) );
+    EXPECT_NE( TelemetryNode::TopicTable::INVALID_ID, small_.Subscribe( "b", callback ) );
+    EXPECT_EQ( TelemetryNode::TopicTable::INVALID_ID, small_.Subscribe( "c", callback ) );
+
+    // More than RX_BUFFER_SIZE bytes without the end of a packet.
+    ByteArray junk( TelemetryConfig::RX_BUFFER_SIZE + 1, 0x55 );
+    EXPECT_EQ( StatusCode::ERROR_RX_DATA_BUFFER_FULL, small_.GiveRxData( junk ) );
+}
+
+TEST_F( ConfigTests, StreamsOfDifferentSizesInteroperate )
+{
+    // Each frame is handed over by the test, a node can't take its peer's STREAM_ACK while still sending.
+    small_.txDataReady_ = etl::delegate<void( const TelemetryNode::ByteArray& )>::create<ConfigTests, &ConfigTests::CaptureSmall>( *this );
+    large_.txDataReady_ = etl::delegate<void( const ByteArray& )>::create<ConfigTests, &ConfigTests::CaptureLarge>( *this );
+    TelemetryNode::ReliableStream smallStream( 10 );
+    ReliableStream largeStream( 10 );
+    small_.AttachStream( &smallStream );
+    large_.AttachStream( &largeStream );
+    small_.Subscribe( "temp", etl::delegate<void( TelemetryNode::ByteArray& )>::create<ConfigTests, &ConfigTests::OnSmall>( *this ) );
+    large_.Subscribe( "temp", etl::delegate<void( ByteArray& )>::create<ConfigTests, &ConfigTests::OnLarge>( *this ) );
+
+    EXPECT_EQ( StatusCode::SUCCESS, large_.PublishStream( "temp", { 0x05, 0x06 } ) );
+    small_.GiveRxData( largeFrame_ );
+    large_.GiveRxData( smallFrame_ );
+    EXPECT_EQ( 1, calls_ );
+    EXPECT_EQ( TelemetryNode::ByteArray( { 0x05, 0x06 } ), received_ );
+    EXPECT_EQ( 0, largeStream.TxInFlight() );
+
+    EXPECT_EQ( StatusCode::SUCCESS, small_.PublishStream( "temp", { 0x07 } ) );
+    large_.GiveRxData( smallFrame_ );
+    small_.GiveRxData( largeFrame_ );
+    EXPECT_EQ( 2, calls_ );
+    EXPECT_EQ( 0, smallStream.TxInFlight() );
+}
+
+class LockPolicyTests : public ::testing::Test
+{
+   public:
+    void Loopback( const ByteArray& data ) { node_.GiveRxData( const_cast<ByteArray&>( data ) ); }
+    void Capture( const ByteArray& data ) { frame_ = data; }
+    void OnData( ByteArray& ) { ++calls_; }
+
+   protected:
+    SingleThreadNode node_;
+    ByteArray frame_;
+    std::atomic<int> calls_;
+
+    LockPolicyTests() : calls_( 0 ) {}
+
+    virtual ~LockPolicyTests() {}
+};
+
+TEST_F( LockPolicyTests, NoLockPublishWaitInLoopback )
+{
+    // The ACK comes back before PublishInternal() returns, so there's nothing to wait for.
+    node_.txDataReady_ = etl::delegate<void( const ByteArray& )>::create<LockPolicyTests, &LockPolicyTests::Loopback>( *this );
+    node_.Subscribe( "topic", etl::delegate<void( ByteArray& )>::create<LockPolicyTests, &LockPolicyTests::OnData>( *this ) );
+    EXPECT_EQ( PublishResponse::SUCCESS, node_.PublishWait( "topic", { 0x01 }, 1000 ) );
+    EXPECT_EQ( 1, calls_ );
+    EXPECT_EQ( 0u, node_.NumThreadsWaiting() );
+
+    // Nothing connected, so no ACK and no point blocking.
+    node_.txDataReady_ = etl::delegate<void( const ByteArray& )>::create<LockPolicyTests, &LockPolicyTests::Capture>( *this );
+    EXPECT_EQ( PublishResponse::TIMEOUT, node_.PublishWait( "topic", { 0x02 }, 1000 ) );
+}
+
+TEST_F( LockPolicyTests, MutexLockWaitSeesEarlyAck )
+{
+    // The ACK (and its notify) came before the wait, so there's nothing to wait for.
+    MutexLock policy;
+    policy.Create();
+    MutexLock::Signal signal;
+    MutexLock::Guard guard( policy, true );
+    bool done = true;
+    uint32_t start = ESF_CLOCK_MS();
+    EXPECT_TRUE( guard.Wait( signal, done, 1000 ) );
+    EXPECT_LT( ESF_CLOCK_MS() - start, 500u );
+
+    done = false;
+    EXPECT_FALSE( guard.Wait( signal, done, 20 ) );
+}
+
+TEST_F( LockPolicyTests, MutexLockWaitsWithThreadSafetyOff )
+{
+    // The mutex isn't held, so the wait polls rather than waiting on the condition variable.
+    EmbeddedSerialFiller node;
+    node.SetThreadSafetyEnabled( false );
+    node.txDataReady_ = etl::delegate<void( const ByteArray& )>::create<LockPolicyTests, &LockPolicyTests::Capture>( *this );
+    uint32_t start = ESF_CLOCK_MS();
+    EXPECT_EQ( PublishResponse::TIMEOUT, node.PublishWait( "topic", { 0x01 }, 20 ) );
+    EXPECT_GE( ESF_CLOCK_MS() - start, 20u );
+}
+
+TEST_F( LockPolicyTests, SpinLockSerialisesRx )
+{
+    node_.txDataReady_ = etl::delegate<void( const ByteArray& )>::create<LockPolicyTests, &LockPolicyTests::Capture>( *this );
+    node_.Publish( "topic", { 0x01, 0x02, 0x03 } );
+    const ByteArray frame = frame_;
+
+    SpinNode receiver;
+    receiver.Subscribe( "topic", etl::delegate<void( ByteArray& )>::create<LockPolicyTests, &LockPolicyTests::OnData>( *this ) );
+
+    // Both threads share the receive buffer, so without the lock they would corrupt each other's packets.
+    auto feed = [ & ]() {
+        for( int i = 0; i < 200; ++i )
+        {
+            ByteArray rxData( frame );
+            receiver.GiveRxData( rxData );
+        }
+    };
+    std::thread t1( feed );
+    std::thread t2( feed );
+    t1.join();
+    t2.join();
+    EXPECT_EQ( 400, calls_ );
+}
+
+}  // namespace
@@ -0,0 +1,143 @@
+/**
+ * \file    DumpDecoderTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include <vector>
+
+#include "DumpDecoder.h"
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "TwoNodeFixture.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+using namespace esf_tools;
+
+namespace
+{
+class DumpDecoderTests : public esf_test::TwoNodeFixture
+{
+   protected:
+    TopicDictionary dictionary1_;
+    TopicDictionary dictionary2_;
+    // Everything node1 sent, as a UART dump of that direction would hold it.
+    std::vector<uint8_t> dump_;
+    std::vector<DumpFrame> frames_;
+    std::vector<std::vector<uint8_t> > data_;
+
+    DumpDecoderTests()
+    {
+        node1_.AttachDictionary( &dictionary1_ );
+        node2_.AttachDictionary( &dictionary2_ );
+    }
+
+    virtual ~DumpDecoderTests() {}
+
+    virtual bool FromNode1( const ByteArray& frame )
+    {
+        dump_.insert( dump_.end(), frame.begin(), frame.end() );
+        return true;
+    }
+
+    /// \brief      Publishes \p count messages of 1 to 40 bytes, alternating between two topics.
+    void PublishAll( int count )
+    {
+        for( int i = 0; i < count; ++i )
+        {
+            node1_.Publish( ( i % 2 ) ? "telemetry/temp" : "log", ByteArray( 1 + i % 40, static_cast<uint8_t>( i ) ) );
+            Pump();
+        }
+    }
+
+    DumpStats Decode( const std::vector<uint8_t>& dump, unsigned threads, size_t blockSize )
+    {
+        frames_.clear();
+        data_.clear();
+        return DumpDecoder( threads, blockSize ).Decode( dump.data(), dump.size(), [this]( const DumpFrame& frame ) {
+            frames_.push_back( frame );
+            data_.push_back( std::vector<uint8_t>( frame.data, frame.data + frame.size ) );
+        } );
+    }
+
+    /// \returns    The messages decoded, in order, checking each is what PublishAll() sent.
+    int CheckMessages( int count )
+    {
+        int message = 0;
+        for( size_t i = 0; i < frames_.size(); ++i )
+        {
+            if( frames_[ i ].type == PacketType::BROADCAST )
+            {
+                EXPECT_EQ( StatusCode::SUCCESS, frames_[ i ].status );
+                EXPECT_EQ( ( message % 2 ) ? "telemetry/temp" : "log", frames_[ i ].topic );
+                EXPECT_EQ( std::vector<uint8_t>( 1 + message % 40, static_cast<uint8_t>( message ) ), data_[ i ] );
+                ++message;
+            }
+        }
+        EXPECT_EQ( count, message );
+        return message;
+    }
+};
+
+TEST_F( DumpDecoderTests, InOrderAcrossThreads )
+{
+    PublishAll( 200 );
+    // Blocks of a few frames each, so the frames are split between the threads many times over.
+    DumpStats stats = Decode( dump_, 4, 64 );
+
+    EXPECT_EQ( dump_.size(), stats.bytes );
+    EXPECT_EQ( stats.frames, stats.decoded );
+    EXPECT_EQ( 0u, stats.incomplete );
+    EXPECT_EQ( frames_.size(), stats.frames );
+    CheckMessages( 200 );
+
+    // Topic IDs were announced, then sent in place of the strings, and resolved.
+    EXPECT_EQ( PacketType::TOPIC_ANNOUNCE, frames_[ 0 ].type );
+    EXPECT_EQ( "log", frames_[ 0 ].topic );
+
+    // The same with one thread and one block.
+    std::vector<DumpFrame> parallel = frames_;
+    Decode( dump_, 1, dump_.size() );
+    ASSERT_EQ( parallel.size(), frames_.size() );
+    for( size_t i = 0; i < frames_.size(); ++i )
+    {
+        EXPECT_EQ( parallel[ i ].offset, frames_[ i ].offset );
+    }
+}
+
+TEST_F( DumpDecoderTests, Errors )
+{
+    PublishAll( 20 );
+    // A flipped bit in a frame some way in, and the dump cut off part way through the last frame.
+    std::vector<uint8_t> dump( dump_ );
+    dump[ dump.size() / 2 ] ^= 0x10;
+    dump.pop_back();
+    dump.pop_back();
+
+    DumpStats stats = Decode( dump, 3, 32 );
+    EXPECT_EQ( 1u, stats.crcErrors + stats.cobsErrors + stats.otherErrors );
+    EXPECT_EQ( 1u, stats.incomplete );
+    EXPECT_EQ( stats.frames - 1, stats.decoded );
+}
+
+TEST_F( DumpDecoderTests, UnknownTopicId )
+{
+    PublishAll( 20 );
+    // Started after the announces, the topic IDs can't be resolved.
+    Decode( dump_, 2, 64 );
+    uint64_t afterAnnounces = 0;
+    for( const auto& frame : frames_ )
+    {
+        if( frame.type == PacketType::TOPIC_ANNOUNCE )
+        {
+            afterAnnounces = frame.offset + frame.encodedSize;
+        }
+    }
+    std::vector<uint8_t> dump( dump_.begin() + afterAnnounces, dump_.end() );
+    DumpStats stats = Decode( dump, 2, 64 );
+    EXPECT_NE( 0u, stats.otherErrors );
+    EXPECT_EQ( StatusCode::ERROR_UNKNOWN_TOPIC_ID, frames_.back().status );
+    EXPECT_TRUE( frames_.back().topic.empty() );
+}
+
+}  // namespace
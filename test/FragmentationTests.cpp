@@ -0,0 +1,164 @@
+/**
+ * \file    FragmentationTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include <vector>
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "TwoNodeFixture.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+const size_t MESSAGE_SIZE = 64 * 1024;
+
+static Topic receivedTopic;
+static std::vector<uint8_t> receivedData;
+static size_t messagesReceived = 0;
+auto messageStore = []( const Topic& topic, const uint8_t* data, size_t size ) {
+    receivedTopic = topic;
+    receivedData.assign( data, data + size );
+    ++messagesReceived;
+};
+
+class FragmentationTests : public esf_test::TwoNodeFixture
+{
+   protected:
+    std::vector<uint8_t> buffer_;
+    FragmentAssembler assembler_;
+    std::vector<uint8_t> message_;
+
+    FragmentationTests() : buffer_( MESSAGE_SIZE ), assembler_( buffer_.data(), buffer_.size() ), message_( MESSAGE_SIZE )
+    {
+        receivedTopic.clear();
+        receivedData.clear();
+        messagesReceived = 0;
+        for( size_t i = 0; i < message_.size(); ++i )
+        {
+            message_[ i ] = static_cast<uint8_t>( i * 7 );
+        }
+        assembler_.messageReceived_ = etl::delegate<void( const Topic&, const uint8_t*, size_t )>( messageStore );
+        node2_.AttachAssembler( &assembler_ );
+    }
+
+    void DeliverAll()
+    {
+        while( Pending( toNode2_ ) )
+        {
+            EXPECT_EQ( StatusCode::SUCCESS, Deliver( toNode2_, node2_ ) );
+        }
+    }
+
+    virtual ~FragmentationTests() {}
+};
+
+TEST_F( FragmentationTests, LargeMessage )
+{
+    EXPECT_EQ( StatusCode::SUCCESS, node1_.PublishLarge( "table", message_.data(), message_.size() ) );
+    EXPECT_EQ( FragmentAssembler::FragmentCount( MESSAGE_SIZE ), toNode2_.size() );
+    for( auto& frame : toNode2_ )
+    {
+        EXPECT_LE( frame.size(), static_cast<size_t>( ESF_MAX_PACKET_SIZE ) );
+    }
+    DeliverAll();
+
+    ASSERT_EQ( 1u, messagesReceived );
+    EXPECT_EQ( Topic( "table" ), receivedTopic );
+    EXPECT_TRUE( message_ == receivedData );
+}
+
+TEST_F( FragmentationTests, EmptyAndSingleFragment )
+{
+    node1_.PublishLarge( "empty", nullptr, 0 );
+    EXPECT_EQ( 1u, toNode2_.size() );
+    DeliverAll();
+    EXPECT_EQ( 1u, messagesReceived );
+    EXPECT_EQ( 0u, receivedData.size() );
+
+    node1_.PublishLarge( "small", message_.data(), ESF_FRAGMENT_SIZE );
+    EXPECT_EQ( 1u, toNode2_.size() );
+    DeliverAll();
+    EXPECT_EQ( 2u, messagesReceived );
+    EXPECT_EQ( static_cast<size_t>( ESF_FRAGMENT_SIZE ), receivedData.size() );
+}
+
+TEST_F( FragmentationTests, LostFragmentDiscardsMessage )
+{
+    node1_.PublishLarge( "table", message_.data(), 4 * ESF_FRAGMENT_SIZE );
+    toNode2_.erase( toNode2_.begin() + 2 );
+    DeliverAll();
+    EXPECT_EQ( 0u, messagesReceived );
+    EXPECT_EQ( 1u, assembler_.Discarded() );
+
+    // The next message is unaffected.
+    node1_.PublishLarge( "table", message_.data(), 4 * ESF_FRAGMENT_SIZE );
+    DeliverAll();
+    EXPECT_EQ( 1u, messagesReceived );
+    EXPECT_EQ( static_cast<size_t>( 4 * ESF_FRAGMENT_SIZE ), receivedData.size() );
+}
+
+TEST_F( FragmentationTests, BufferTooSmall )
+{
+    uint8_t small[ ESF_FRAGMENT_SIZE ];
+    FragmentAssembler assembler( small, sizeof( small ) );
+    node2_.AttachAssembler( &assembler );
+
+    node1_.PublishLarge( "table", message_.data(), 2 * ESF_FRAGMENT_SIZE );
+    DeliverAll();
+    EXPECT_EQ( 0u, messagesReceived );
+    EXPECT_EQ( 1u, assembler.Discarded() );
+}
+
+// Packets too small for ESF_FRAGMENT_SIZE get smaller fragments, or none at all.
+struct SmallPacketConfig : DefaultConfig
+{
+    static const size_t PACKET_SIZE = 64;
+};
+struct TinyPacketConfig : DefaultConfig
+{
+    static const size_t PACKET_SIZE = 24;
+};
+
+struct SmallPacketSender
+{
+    void Send( const BasicEmbeddedSerialFiller<SmallPacketConfig>::ByteArray& frame ) { frames.push_back( ByteArray( frame.begin(), frame.end() ) ); }
+
+    std::vector<ByteArray> frames;
+};
+
+TEST_F( FragmentationTests, SmallPackets )
+{
+    typedef BasicEmbeddedSerialFiller<SmallPacketConfig> SmallNode;
+    static_assert( ( SmallNode::FRAGMENT_SIZE > 0 ) && ( SmallNode::FRAGMENT_SIZE < ESF_FRAGMENT_SIZE ), "" );
+    SmallNode small;
+    SmallPacketSender sender;
+    small.txDataReady_ = etl::delegate<void( const SmallNode::ByteArray& )>::create<SmallPacketSender, &SmallPacketSender::Send>( sender );
+    EXPECT_EQ( StatusCode::SUCCESS, small.PublishLarge( "table", message_.data(), 1000 ) );
+    EXPECT_EQ( FragmentAssembler::FragmentCount( 1000, SmallNode::FRAGMENT_SIZE ), sender.frames.size() );
+    for( auto& frame : sender.frames )
+    {
+        EXPECT_LE( frame.size(), static_cast<size_t>( SmallPacketConfig::PACKET_SIZE ) );
+        EXPECT_EQ( StatusCode::SUCCESS, node2_.GiveRxData( frame ) );
+    }
+    ASSERT_EQ( 1u, messagesReceived );
+    EXPECT_TRUE( std::equal( receivedData.begin(), receivedData.end(), message_.begin() ) );
+    EXPECT_EQ( 1000u, receivedData.size() );
+
+    static_assert( BasicEmbeddedSerialFiller<TinyPacketConfig>::FRAGMENT_SIZE == 0, "" );
+    BasicEmbeddedSerialFiller<TinyPacketConfig> tiny;
+    EXPECT_EQ( StatusCode::ERROR_MESSAGE_TOO_LARGE, tiny.PublishLarge( "table", message_.data(), 10 ) );
+}
+
+TEST_F( FragmentationTests, NotAttached )
+{
+    node2_.AttachAssembler( nullptr );
+    node1_.PublishLarge( "table", message_.data(), 1 );
+    ByteArray frame = toNode2_.front();
+    EXPECT_EQ( StatusCode::ERROR_ASSEMBLER_NOT_ATTACHED, node2_.GiveRxData( frame ) );
+}
+
+}  // namespace
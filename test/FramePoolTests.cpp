@@ -0,0 +1,133 @@
+/**
+ * \file    FramePoolTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+typedef BasicFramePool<ByteArray, 2> Pool;
+
+struct TwoFrameConfig : DefaultConfig
+{
+    static const size_t FRAMES = 2;
+};
+typedef BasicEmbeddedSerialFiller<TwoFrameConfig> TwoFrameNode;
+
+class FramePoolTests : public ::testing::Test
+{
+   public:
+    void Loopback( const TwoFrameNode::ByteArray& data ) { status_ = node_.GiveRxData( const_cast<TwoFrameNode::ByteArray&>( data ) ); }
+    void Capture( const TwoFrameNode::ByteArray& data ) { frame_ = data; }
+    void Reply( TwoFrameNode::ByteArray& data ) { replyId_ = node_.Publish( "reply", data ); }
+    void ReplyWait( TwoFrameNode::ByteArray& data ) { waitResult_ = node_.PublishWait( "reply", data, 1000 ); }
+
+   protected:
+    Pool pool_;
+    TwoFrameNode node_;
+    TwoFrameNode::ByteArray frame_;
+    StatusCode status_;
+    uint8_t replyId_;
+    PublishResponse waitResult_;
+
+    FramePoolTests() : status_( StatusCode::SUCCESS ), replyId_( 0xFF ), waitResult_( PublishResponse::UNKNOWN ) { node_.SetThreadSafetyEnabled( false ); }
+
+    virtual ~FramePoolTests() {}
+};
+
+TEST_F( FramePoolTests, AcquireAndRelease )
+{
+    ByteArray* first = pool_.Acquire();
+    ByteArray* second = pool_.Acquire();
+    ASSERT_NE( nullptr, first );
+    ASSERT_NE( nullptr, second );
+    EXPECT_NE( first, second );
+    EXPECT_EQ( 0u, pool_.Available() );
+    EXPECT_EQ( nullptr, pool_.Acquire() );
+    EXPECT_EQ( 1u, pool_.Misses() );
+
+    // Frames come back empty.
+    first->push_back( 0x01 );
+    pool_.Release( first );
+    EXPECT_EQ( 1u, pool_.Available() );
+    EXPECT_EQ( first, pool_.Acquire() );
+    EXPECT_TRUE( first->empty() );
+
+    pool_.Release( first );
+    pool_.Release( second );
+    EXPECT_EQ( 2u, pool_.Available() );
+    EXPECT_EQ( 0u, pool_.LowWater() );
+}
+
+TEST_F( FramePoolTests, HandleReleases )
+{
+    {
+        Pool::Handle handle( pool_ );
+        ASSERT_TRUE( static_cast<bool>( handle ) );
+        EXPECT_EQ( 1u, pool_.Available() );
+
+        handle.Release();
+        EXPECT_EQ( 2u, pool_.Available() );
+        EXPECT_FALSE( static_cast<bool>( handle ) );
+    }
+    EXPECT_EQ( 2u, pool_.Available() );
+
+    {
+        Pool::Handle first( pool_ );
+        Pool::Handle second( pool_ );
+        Pool::Handle third( pool_ );
+        EXPECT_FALSE( static_cast<bool>( third ) );
+    }
+    EXPECT_EQ( 2u, pool_.Available() );
+    EXPECT_EQ( 1u, pool_.Misses() );
+}
+
+TEST_F( FramePoolTests, NodeRunsOutOfFrames )
+{
+    // The packet's frame is released before it is emitted, but receiving it in loopback needs two more.
+    node_.txDataReady_ = etl::delegate<void( const TwoFrameNode::ByteArray& )>::create<FramePoolTests, &FramePoolTests::Loopback>( *this );
+    uint32_t misses = TwoFrameNode::Frames().Misses();
+    node_.Publish( "topic", { 0x01 } );
+    EXPECT_EQ( StatusCode::ERROR_NO_FREE_FRAMES, status_ );
+    EXPECT_EQ( misses + 1, TwoFrameNode::Frames().Misses() );
+    EXPECT_EQ( 0u, TwoFrameNode::Frames().LowWater() );
+    EXPECT_EQ( 2u, TwoFrameNode::Frames().Available() );
+
+    // With both frames free, receiving it is fine.
+    node_.txDataReady_ = etl::delegate<void( const TwoFrameNode::ByteArray& )>::create<FramePoolTests, &FramePoolTests::Capture>( *this );
+    node_.Publish( "topic", { 0x01 } );
+    EXPECT_EQ( StatusCode::SUCCESS, node_.GiveRxData( frame_ ) );
+}
+
+TEST_F( FramePoolTests, PublishReportsNoFrames )
+{
+    node_.txDataReady_ = etl::delegate<void( const TwoFrameNode::ByteArray& )>::create<FramePoolTests, &FramePoolTests::Capture>( *this );
+    EXPECT_NE( 0, node_.Publish( "topic", { 0x01 } ) );
+
+    // GiveRxData() holds both frames across the callback, leaving none to publish the reply in.
+    node_.Subscribe( "topic", etl::delegate<void( TwoFrameNode::ByteArray& )>::create<FramePoolTests, &FramePoolTests::Reply>( *this ) );
+    EXPECT_EQ( StatusCode::SUCCESS, node_.GiveRxData( frame_ ) );
+    EXPECT_EQ( 0, replyId_ );
+    EXPECT_EQ( 1u, node_.Stats().errors[ static_cast<size_t>( StatusCode::ERROR_NO_FREE_FRAMES ) ] );
+}
+
+TEST_F( FramePoolTests, PublishWaitDoesntWaitForAnUnsentPacket )
+{
+    node_.txDataReady_ = etl::delegate<void( const TwoFrameNode::ByteArray& )>::create<FramePoolTests, &FramePoolTests::Capture>( *this );
+    node_.Publish( "topic", { 0x01 } );
+    node_.Subscribe( "topic", etl::delegate<void( TwoFrameNode::ByteArray& )>::create<FramePoolTests, &FramePoolTests::ReplyWait>( *this ) );
+
+    uint32_t start = ESF_CLOCK_MS();
+    EXPECT_EQ( StatusCode::SUCCESS, node_.GiveRxData( frame_ ) );
+    EXPECT_LT( ESF_CLOCK_MS() - start, 500u );
+    EXPECT_TRUE( waitResult_ == PublishResponse::NOT_SENT );
+    EXPECT_EQ( 0u, node_.Stats().ackTimeouts );
+    EXPECT_EQ( 1u, node_.Stats().errors[ static_cast<size_t>( StatusCode::ERROR_NO_FREE_FRAMES ) ] );
+}
+
+}  // namespace
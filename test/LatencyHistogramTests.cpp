@@ -0,0 +1,79 @@
+/**
+ * \file    LatencyHistogramTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/LatencyHistogram.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+class LatencyHistogramTests : public ::testing::Test
+{
+   protected:
+    LatencyHistogram histogram_;
+
+    LatencyHistogramTests() {}
+    virtual ~LatencyHistogramTests() {}
+};
+
+TEST_F( LatencyHistogramTests, Buckets )
+{
+    // Small values are exact.
+    for( uint32_t value = 0; value < 2 * LatencyHistogram::SUB_BUCKETS; ++value )
+    {
+        EXPECT_EQ( value, LatencyHistogram::Bucket( value ) );
+        EXPECT_EQ( value, LatencyHistogram::Upper( value ) );
+    }
+    // Every value is in a bucket no wider than 1 / SUB_BUCKETS of it, and the buckets follow on from each other.
+    uint32_t lower = 0;
+    for( size_t i = 0; i < LatencyHistogram::BUCKETS - 1; ++i )
+    {
+        uint32_t upper = LatencyHistogram::Upper( i );
+        EXPECT_EQ( i, LatencyHistogram::Bucket( lower ) );
+        EXPECT_EQ( i, LatencyHistogram::Bucket( upper ) );
+        EXPECT_LE( ( upper - lower ) * LatencyHistogram::SUB_BUCKETS, lower );
+        lower = upper + 1;
+    }
+    EXPECT_EQ( LatencyHistogram::BUCKETS - 1, LatencyHistogram::Bucket( UINT32_MAX ) );
+}
+
+TEST_F( LatencyHistogramTests, Percentiles )
+{
+    EXPECT_EQ( 0u, histogram_.Percentile( 50 ) );
+    for( uint32_t value = 1; value <= 1000; ++value )
+    {
+        histogram_.Add( value );
+    }
+    EXPECT_EQ( 1000u, histogram_.Count() );
+    EXPECT_EQ( 1u, histogram_.Min() );
+    EXPECT_EQ( 1000u, histogram_.Max() );
+    // Within the width of a bucket above the exact values.
+    const uint32_t percents[] = { 50, 90, 99 };
+    for( uint32_t percent : percents )
+    {
+        uint32_t exact = percent * 10;
+        EXPECT_GE( histogram_.Percentile( percent ), exact );
+        EXPECT_LE( histogram_.Percentile( percent ), exact + exact / LatencyHistogram::SUB_BUCKETS );
+    }
+    EXPECT_EQ( 1000u, histogram_.Percentile( 100 ) );
+}
+
+TEST_F( LatencyHistogramTests, LongValuesAndReset )
+{
+    histogram_.Add( 10 );
+    histogram_.Add( 1000000 );
+    EXPECT_EQ( 1u, histogram_[ LatencyHistogram::BUCKETS - 1 ] );
+    EXPECT_EQ( 10u, histogram_.Percentile( 50 ) );
+    EXPECT_EQ( 1000000u, histogram_.Percentile( 99 ) );
+
+    histogram_.Reset();
+    EXPECT_EQ( 0u, histogram_.Count() );
+    EXPECT_EQ( 0u, histogram_.Max() );
+    EXPECT_EQ( 0u, histogram_[ LatencyHistogram::BUCKETS - 1 ] );
+}
+
+}  // namespace
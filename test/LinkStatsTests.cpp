@@ -0,0 +1,103 @@
+/**
+ * \file    LinkStatsTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include <atomic>
+#include <thread>
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "TwoNodeFixture.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+class LinkStatsTests : public esf_test::TwoNodeFixture
+{
+   protected:
+    size_t frameSize_;
+
+    LinkStatsTests() : frameSize_( 0 ) {}
+
+    virtual ~LinkStatsTests() {}
+
+    virtual bool FromNode1( const ByteArray& frame )
+    {
+        frameSize_ = frame.size();
+        return true;
+    }
+
+   public:
+    void Reply( ByteArray& ) { node2_.Publish( "reply", ByteArray( 4, 0x01 ) ); }
+};
+
+TEST_F( LinkStatsTests, FramesAndBytes )
+{
+    node2_.Subscribe( "topic", etl::delegate<void( ByteArray& )>::create<LinkStatsTests, &LinkStatsTests::Reply>( *this ) );
+    for( int i = 0; i < 10; ++i )
+    {
+        node1_.Publish( "topic", ByteArray( 20, static_cast<uint8_t>( i ) ) );
+    }
+    Pump();
+
+    LinkStats sent = node1_.Stats();
+    LinkStats received = node2_.Stats();
+    EXPECT_EQ( 10u, sent.framesOut );
+    EXPECT_EQ( 10u * frameSize_, sent.bytesOut );
+    EXPECT_EQ( sent.framesOut, received.framesIn );
+    EXPECT_EQ( sent.bytesOut, received.bytesIn );
+    EXPECT_EQ( frameSize_, received.rxHighWater );
+    // The replies.
+    EXPECT_EQ( 10u, received.framesOut );
+    EXPECT_EQ( received.bytesOut, sent.bytesIn );
+    for( size_t i = 0; i < STATUS_CODES; ++i )
+    {
+        EXPECT_EQ( 0u, sent.errors[ i ] + received.errors[ i ] );
+    }
+    EXPECT_EQ( 0u, sent.ackTimeouts + sent.retransmits );
+}
+
+TEST_F( LinkStatsTests, ErrorsAndTimeouts )
+{
+    // [ 0x01, 0x02 ] and a wrong CRC, COBS encoded.
+    ByteArray corrupt( { 0x05, 0x01, 0x02, 0x03, 0x04, 0x00 } );
+    EXPECT_EQ( StatusCode::ERROR_CRC_CHECK_FAILED, node2_.GiveRxData( corrupt ) );
+    EXPECT_EQ( 1u, node2_.Stats().Errors( StatusCode::ERROR_CRC_CHECK_FAILED ) );
+    EXPECT_EQ( 1u, node2_.Stats().framesIn );
+
+    // Nothing is delivered, so nothing is acknowledged.
+    EXPECT_EQ( PublishResponse::TIMEOUT, node1_.PublishWait( "topic", ByteArray( 4, 0x01 ), 5 ) );
+    node1_.SetRetransmissionTimeouts( 5, 5, 5 );
+    EXPECT_EQ( PublishResponse::TIMEOUT, node1_.PublishReliable( "topic", ByteArray( 4, 0x01 ), 2 ) );
+    LinkStats stats = node1_.Stats();
+    EXPECT_EQ( 2u, stats.ackTimeouts );
+    EXPECT_EQ( 2u, stats.retransmits );
+    EXPECT_EQ( 4u, stats.framesOut );
+}
+
+TEST_F( LinkStatsTests, ConsistentWhileSending )
+{
+    // Every frame is the same size, so each read must have exactly that many bytes for its frames.
+    node1_.Publish( "topic", ByteArray( 20, 0x55 ) );
+    size_t frameSize = frameSize_;
+    std::atomic<bool> done( false );
+    std::thread reader( [&]() {
+        while( !done )
+        {
+            LinkStats stats = node1_.Stats();
+            ASSERT_EQ( stats.framesOut * frameSize, stats.bytesOut );
+        }
+    } );
+    for( int i = 0; i < 20000; ++i )
+    {
+        node1_.Publish( "topic", ByteArray( 20, 0x55 ) );
+    }
+    done = true;
+    reader.join();
+    EXPECT_EQ( 20001u, node1_.Stats().framesOut );
+}
+
+}  // namespace
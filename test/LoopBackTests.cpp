@@ -248,4 +248,71 @@ TEST_F( LoopBackTests, NoDataTest )
     EXPECT_EQ( ByteArray( {} ), savedData2 );
 }
 
+TEST_F( LoopBackTests, UnsubscribeLastSubscriberTest )
+{
+    embeddedSF.noSubscribersForTopic_ = etl::delegate<void( const Topic& topic, const ByteArray& data )>::create<LoopBackTests, &LoopBackTests::noSubscriberHandler>( *this );
+    uint32_t id = embeddedSF.Subscribe( "topic1", etl::delegate<void( ByteArray & data )>( dataStore1 ) );
+
+    noSubscribersForTopicEventFired = false;
+    embeddedSF.Publish( "topic1", { 'h', 'i' } );
+    EXPECT_FALSE( noSubscribersForTopicEventFired );
+
+    // Once the last subscriber has gone the topic is treated as unknown.
+    EXPECT_EQ( StatusCode::SUCCESS, embeddedSF.Unsubscribe( id ) );
+    EXPECT_EQ( StatusCode::ERROR_UNRECOGNISED_SUBSCRIBER, embeddedSF.Unsubscribe( id ) );
+    embeddedSF.Publish( "topic1", { 'h', 'i' } );
+    EXPECT_TRUE( noSubscribersForTopicEventFired );
+    EXPECT_EQ( Topic( "topic1" ), savedNoSubscriberTopic );
+}
+
+TEST_F( LoopBackTests, TopicHandleTest )
+{
+    TopicHandle topic = EmbeddedSerialFiller::RegisterTopic( "sensor/imu" );
+    embeddedSF.Subscribe( topic, etl::delegate<void( ByteArray & data )>( dataStore1 ) );
+    embeddedSF.Subscribe( "sensor/imu", etl::delegate<void( ByteArray & data )>( dataStore2 ) );
+
+    // Handles and strings are interchangeable.
+    callbackCalled = false;
+    embeddedSF.Publish( topic, { 'h', 'i' } );
+    EXPECT_EQ( ByteArray( { 'h', 'i' } ), savedData1 );
+    EXPECT_TRUE( callbackCalled );
+
+    // Removes both subscribers.
+    EXPECT_EQ( StatusCode::SUCCESS, embeddedSF.Unsubscribe( topic ) );
+    EXPECT_EQ( StatusCode::ERROR_UNRECOGNISED_SUBSCRIBER, embeddedSF.Unsubscribe( topic ) );
+    savedData1.clear();
+    callbackCalled = false;
+    embeddedSF.Publish( "sensor/imu", { 'h', 'i' } );
+    EXPECT_EQ( ByteArray( {} ), savedData1 );
+    EXPECT_FALSE( callbackCalled );
+}
+
+TEST_F( LoopBackTests, WildcardTest )
+{
+    embeddedSF.noSubscribersForTopic_ = etl::delegate<void( const Topic&, const ByteArray& )>::create<LoopBackTests, &LoopBackTests::noSubscriberHandler>( *this );
+    uint32_t id = embeddedSF.Subscribe( "motor/*", etl::delegate<void( ByteArray & data )>( dataStore1 ) );
+    embeddedSF.Subscribe( "motor/left", etl::delegate<void( ByteArray & data )>( dataStore2 ) );
+
+    // Both the exact and wildcard subscribers are called.
+    callbackCalled = false;
+    embeddedSF.Publish( "motor/left", { 'h', 'i' } );
+    EXPECT_EQ( ByteArray( { 'h', 'i' } ), savedData1 );
+    EXPECT_TRUE( callbackCalled );
+
+    callbackCalled = false;
+    embeddedSF.Publish( "motor/right", { 'y', 'o' } );
+    EXPECT_EQ( ByteArray( { 'y', 'o' } ), savedData1 );
+    EXPECT_FALSE( callbackCalled );
+
+    noSubscribersForTopicEventFired = false;
+    embeddedSF.Publish( "servo/left", { 'h', 'i' } );
+    EXPECT_TRUE( noSubscribersForTopicEventFired );
+
+    EXPECT_EQ( StatusCode::SUCCESS, embeddedSF.Unsubscribe( id ) );
+    EXPECT_EQ( StatusCode::ERROR_UNRECOGNISED_SUBSCRIBER, embeddedSF.Unsubscribe( id ) );
+    noSubscribersForTopicEventFired = false;
+    embeddedSF.Publish( "motor/right", { 'h', 'i' } );
+    EXPECT_TRUE( noSubscribersForTopicEventFired );
+}
+
 }  // namespace
@@ -0,0 +1,139 @@
+/**
+ * \file    LossyLinkTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include <vector>
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "LossyLink.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+using namespace esf_sim;
+
+namespace
+{
+typedef LossyLink<EmbeddedSerialFiller, EmbeddedSerialFiller> Link;
+
+const uint32_t RETRANSMIT_TIMEOUT = 20;
+
+class LossyLinkTests : public ::testing::Test
+{
+   public:
+    void OnData( ByteArray& data ) { received_.push_back( data ); }
+
+   protected:
+    EmbeddedSerialFiller node1_;
+    EmbeddedSerialFiller node2_;
+    std::vector<ByteArray> received_;
+
+    LossyLinkTests() { node2_.Subscribe( "topic", etl::delegate<void( ByteArray& )>::create<LossyLinkTests, &LossyLinkTests::OnData>( *this ) ); }
+
+    virtual ~LossyLinkTests() {}
+};
+
+TEST_F( LossyLinkTests, LatencyAndPacing )
+{
+    ChannelModel model;
+    model.latency = 1000;
+    model.baud = 100000;
+    Link link( node1_, node2_, model, 1 );
+
+    node1_.Publish( "topic", { 0x01, 0x02 } );
+    // [ COBS, type, ID, length, "topic", 2 data, 2 CRC, 0x00 ] at 100us a byte.
+    const uint64_t arrival = 14 * 100 + 1000;
+    EXPECT_EQ( arrival, link.NextArrival() );
+    link.AdvanceTo( arrival - 1 );
+    EXPECT_TRUE( received_.empty() );
+    link.AdvanceTo( arrival );
+    ASSERT_EQ( 1u, received_.size() );
+    EXPECT_EQ( ByteArray( { 0x01, 0x02 } ), received_[ 0 ] );
+    EXPECT_EQ( Channel::NEVER, link.NextArrival() );
+    EXPECT_EQ( 1u, link.ToB().Stats().frames );
+    EXPECT_EQ( 0u, link.ToB().Stats().bitErrors );
+}
+
+TEST_F( LossyLinkTests, SameSeedSameNoise )
+{
+    ChannelModel model;
+    model.bitErrorRate = 1e-3;
+    model.byteDropRate = 1e-3;
+    model.burstRate = 1e-3;
+    model.burstBytes = 4;
+    model.duplicateRate = 0.05;
+    model.reorderRate = 0.05;
+    model.reorderDelay = 500;
+    model.baud = 115200;
+
+    std::vector<size_t> counts;
+    std::vector<uint64_t> bitErrors;
+    for( int run = 0; run < 2; ++run )
+    {
+        received_.clear();
+        Link link( node1_, node2_, model, 42 );
+        for( uint8_t i = 0; i < 200; ++i )
+        {
+            node1_.Publish( "topic", ByteArray( 32, i ) );
+            link.Advance( 100 );
+        }
+        link.RunUntilIdle();
+        counts.push_back( received_.size() );
+        bitErrors.push_back( link.ToB().Stats().bitErrors );
+        EXPECT_NE( 0u, link.ToB().Stats().bursts );
+        EXPECT_NE( 0u, link.ToB().Stats().duplicated );
+    }
+    EXPECT_EQ( counts[ 0 ], counts[ 1 ] );
+    EXPECT_EQ( bitErrors[ 0 ], bitErrors[ 1 ] );
+    EXPECT_NE( 0u, bitErrors[ 0 ] );
+    EXPECT_LT( counts[ 0 ], 200u );
+}
+
+TEST_F( LossyLinkTests, DropsEverything )
+{
+    ChannelModel model;
+    model.byteDropRate = 1.0;
+    Link link( node1_, node2_, model, 1 );
+
+    node1_.Publish( "topic", { 0x01 } );
+    link.RunUntilIdle();
+    EXPECT_TRUE( received_.empty() );
+    EXPECT_EQ( link.ToB().Stats().bytes, link.ToB().Stats().droppedBytes );
+}
+
+TEST_F( LossyLinkTests, StreamRecoversFromNoise )
+{
+    ChannelModel model;
+    model.bitErrorRate = 1e-3;
+    model.latency = 500;
+    model.baud = 115200;
+    Link link( node1_, node2_, model, 7 );
+    ReliableStream stream1( RETRANSMIT_TIMEOUT );
+    ReliableStream stream2( RETRANSMIT_TIMEOUT );
+    node1_.AttachStream( &stream1 );
+    node2_.AttachStream( &stream2 );
+    node2_.Subscribe( "stream", etl::delegate<void( ByteArray& )>::create<LossyLinkTests, &LossyLinkTests::OnData>( *this ) );
+
+    uint8_t next = 0;
+    for( int ms = 0; ( ms < 10000 ) && ( received_.size() < 50 ); ++ms )
+    {
+        while( ( next < 50 ) && ( node1_.PublishStream( "stream", ByteArray( 16, next ) ) == StatusCode::SUCCESS ) )
+        {
+            ++next;
+        }
+        link.Advance( 1000 );
+        node1_.Poll( 1 );
+        node2_.Poll( 1 );
+    }
+
+    // Everything, in order, however many frames the noise took.
+    ASSERT_EQ( 50u, received_.size() );
+    for( uint8_t i = 0; i < 50; ++i )
+    {
+        EXPECT_EQ( ByteArray( 16, i ), received_[ i ] );
+    }
+    EXPECT_NE( 0u, stream1.Retransmissions() );
+}
+
+}  // namespace
@@ -0,0 +1,153 @@
+/**
+ * \file    ReliableStreamTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "TwoNodeFixture.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+static std::vector<ByteArray> received;
+auto dataStore = []( ByteArray& data ) { received.push_back( data ); };
+
+const uint32_t RETRANSMIT_TIMEOUT = 10;
+
+class ReliableStreamTests : public esf_test::TwoNodeFixture
+{
+   protected:
+    ReliableStream stream1_;
+    ReliableStream stream2_;
+
+    ReliableStreamTests() : stream1_( RETRANSMIT_TIMEOUT ), stream2_( RETRANSMIT_TIMEOUT )
+    {
+        received.clear();
+        node1_.AttachStream( &stream1_ );
+        node2_.AttachStream( &stream2_ );
+        node2_.Subscribe( "stream", etl::delegate<void( ByteArray & data )>( dataStore ) );
+    }
+
+    virtual ~ReliableStreamTests() {}
+};
+
+TEST_F( ReliableStreamTests, NotAttached )
+{
+    EmbeddedSerialFiller node;
+    EXPECT_EQ( StatusCode::ERROR_STREAM_NOT_ATTACHED, node.PublishStream( "stream", { 0x01 } ) );
+}
+
+TEST_F( ReliableStreamTests, InOrderDelivery )
+{
+    for( uint8_t i = 0; i < ESF_STREAM_WINDOW_SIZE; ++i )
+    {
+        EXPECT_EQ( StatusCode::SUCCESS, node1_.PublishStream( "stream", { i } ) );
+    }
+    Pump();
+
+    ASSERT_EQ( static_cast<size_t>( ESF_STREAM_WINDOW_SIZE ), received.size() );
+    for( uint8_t i = 0; i < ESF_STREAM_WINDOW_SIZE; ++i )
+    {
+        EXPECT_EQ( ByteArray( { i } ), received[ i ] );
+    }
+    EXPECT_EQ( 0, stream1_.TxInFlight() );
+}
+
+TEST_F( ReliableStreamTests, WindowFull )
+{
+    for( uint8_t i = 0; i < ESF_STREAM_WINDOW_SIZE; ++i )
+    {
+        EXPECT_EQ( StatusCode::SUCCESS, node1_.PublishStream( "stream", { i } ) );
+    }
+    EXPECT_EQ( StatusCode::ERROR_STREAM_WINDOW_FULL, node1_.PublishStream( "stream", { 0xFF } ) );
+
+    // Once acknowledged there's room again.
+    Pump();
+    EXPECT_EQ( StatusCode::SUCCESS, node1_.PublishStream( "stream", { 0xFF } ) );
+}
+
+TEST_F( ReliableStreamTests, OnlyLostFrameIsResent )
+{
+    for( uint8_t i = 0; i < 4; ++i )
+    {
+        node1_.PublishStream( "stream", { i } );
+    }
+    // Lose the second frame.
+    toNode2_.erase( toNode2_.begin() + 1 );
+    Pump();
+
+    // Frames after the gap are held back, and the window can't slide past it.
+    ASSERT_EQ( 1u, received.size() );
+    EXPECT_EQ( 3, stream1_.TxInFlight() );
+
+    // Nothing is resent before the timeout...
+    node1_.Poll( RETRANSMIT_TIMEOUT - 1 );
+    EXPECT_TRUE( toNode2_.empty() );
+
+    // ...and only the lost frame after it.
+    node1_.Poll( 1 );
+    EXPECT_EQ( 1u, toNode2_.size() );
+    EXPECT_EQ( 1u, stream1_.Retransmissions() );
+    Pump();
+
+    ASSERT_EQ( 4u, received.size() );
+    for( uint8_t i = 0; i < 4; ++i )
+    {
+        EXPECT_EQ( ByteArray( { i } ), received[ i ] );
+    }
+    EXPECT_EQ( 0, stream1_.TxInFlight() );
+}
+
+TEST_F( ReliableStreamTests, LostAckIsNotDeliveredTwice )
+{
+    node1_.PublishStream( "stream", { 0x01 } );
+    Deliver( toNode2_, node2_ );
+    // Lose the acknowledge.
+    toNode1_.clear();
+    ASSERT_EQ( 1u, received.size() );
+
+    node1_.Poll( RETRANSMIT_TIMEOUT );
+    Pump();
+
+    EXPECT_EQ( 1u, received.size() );
+    EXPECT_EQ( 0, stream1_.TxInFlight() );
+}
+
+TEST_F( ReliableStreamTests, SequenceWrapsAround )
+{
+    const uint32_t count = 0x10000 + 2 * ESF_STREAM_WINDOW_SIZE;
+    uint32_t delivered = 0;
+    for( uint32_t i = 0; i < count; ++i )
+    {
+        ASSERT_EQ( StatusCode::SUCCESS, node1_.PublishStream( "stream", { static_cast<uint8_t>( i ) } ) );
+        Pump();
+        ASSERT_EQ( 1u, received.size() );
+        EXPECT_EQ( static_cast<uint8_t>( i ), received[ 0 ][ 0 ] );
+        received.clear();
+        ++delivered;
+    }
+    EXPECT_EQ( count, delivered );
+}
+
+TEST( BasicReliableStreamTests, SlotsAreSizedByPacketSize )
+{
+    // Every slot of the window holds a packet of the stream's size, not ESF_MAX_PACKET_SIZE.
+    typedef BasicReliableStream<16> SmallStream;
+    EXPECT_LT( sizeof( SmallStream ), sizeof( ReliableStream ) );
+
+    SmallStream stream( RETRANSMIT_TIMEOUT );
+    ByteArray packet( { 0x53, 0x00, 0x00, 0x01, 's', 0x2A, 0x00, 0x00 } );
+    EXPECT_EQ( SmallStream::RxVerdict::ACCEPTED, stream.RxAccept( 0, packet ) );
+    ASSERT_NE( nullptr, stream.RxNextInOrder() );
+    EXPECT_TRUE( std::equal( packet.begin(), packet.end(), stream.RxNextInOrder()->begin() ) );
+    stream.RxRelease();
+    EXPECT_EQ( nullptr, stream.RxNextInOrder() );
+}
+
+}  // namespace
@@ -0,0 +1,135 @@
+/**
+ * \file    RetransmissionTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "TwoNodeFixture.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+static size_t received = 0;
+auto dataCount = []( ByteArray& ) { ++received; };
+
+const uint32_t RTO = 20;
+
+class RetransmissionTests : public esf_test::TwoNodeFixture
+{
+   protected:
+    size_t sent_;
+    size_t dropFirst_;
+
+    RetransmissionTests() : sent_( 0 ), dropFirst_( 0 )
+    {
+        received = 0;
+        node1_.SetRetransmissionTimeouts( RTO, RTO, 4 * RTO );
+        node2_.Subscribe( "topic", etl::delegate<void( ByteArray & data )>( dataCount ) );
+    }
+
+    // The first dropFirst_ frames from node 1 are lost.
+    virtual bool FromNode1( const ByteArray& /* frame */ ) { return sent_++ >= dropFirst_; }
+
+    // Runs the publish on another thread, delivering frames until it completes.
+    PublishResponse PumpUntilDone( std::function<PublishResponse()> publish )
+    {
+        PublishResponse result = PublishResponse::UNKNOWN;
+        bool done = false;
+        std::thread t1( [ & ]() {
+            result = publish();
+            std::lock_guard<std::mutex> lock( mutex_ );
+            done = true;
+        } );
+        for( ;; )
+        {
+            Pump();
+            {
+                std::lock_guard<std::mutex> lock( mutex_ );
+                if( done )
+                {
+                    break;
+                }
+            }
+            std::this_thread::yield();
+        }
+        t1.join();
+        return result;
+    }
+
+    virtual ~RetransmissionTests() {}
+};
+
+TEST_F( RetransmissionTests, FirstSample )
+{
+    RttEstimator rtt( 1000, 10, 10000 );
+    EXPECT_EQ( 1000u, rtt.Rto() );
+
+    // RTO = R + 4 * R / 2
+    rtt.AddSample( 100 );
+    EXPECT_EQ( 100u, rtt.SmoothedRtt() );
+    EXPECT_EQ( 50u, rtt.RttVariance() );
+    EXPECT_EQ( 300u, rtt.Rto() );
+}
+
+TEST_F( RetransmissionTests, ConvergesOnStableRtt )
+{
+    RttEstimator rtt( 1000, 10, 10000 );
+    for( int i = 0; i < 100; ++i )
+    {
+        rtt.AddSample( 100 );
+    }
+    EXPECT_EQ( 100u, rtt.SmoothedRtt() );
+    // The variance decays away to within the fixed point rounding.
+    EXPECT_GT( rtt.Rto(), 100u );
+    EXPECT_LT( rtt.Rto(), 105u );
+}
+
+TEST_F( RetransmissionTests, Bounds )
+{
+    RttEstimator rtt( 1000, 10, 2000 );
+    rtt.AddSample( 1 );
+    EXPECT_EQ( 10u, rtt.Rto() );
+
+    EXPECT_EQ( 1600u, rtt.Backoff( 800 ) );
+    EXPECT_EQ( 2000u, rtt.Backoff( 1600 ) );
+    EXPECT_EQ( 2000u, rtt.Backoff( 2000 ) );
+}
+
+TEST_F( RetransmissionTests, PublishWaitMeasuresRtt )
+{
+    EXPECT_EQ( PublishResponse::SUCCESS, PumpUntilDone( [ & ]() { return node1_.PublishWait( "topic", { 0x01 }, 1000 ); } ) );
+    EXPECT_EQ( 1u, node1_.RoundTripTime().Samples() );
+    LatencyHistogram latency = node1_.AckLatency();
+    EXPECT_EQ( 1u, latency.Count() );
+    EXPECT_EQ( node1_.RoundTripTime().SmoothedRtt(), latency.Max() );
+    node1_.ResetAckLatency();
+    EXPECT_EQ( 0u, node1_.AckLatency().Count() );
+}
+
+TEST_F( RetransmissionTests, LostPacketIsResent )
+{
+    dropFirst_ = 1;
+    EXPECT_EQ( PublishResponse::SUCCESS, PumpUntilDone( [ & ]() { return node1_.PublishReliable( "topic", { 0x01 }, 3 ); } ) );
+    EXPECT_EQ( 2u, sent_ );
+    EXPECT_EQ( 1u, received );
+    // Karn's algorithm, no sample from a retransmitted packet.
+    EXPECT_EQ( 0u, node1_.RoundTripTime().Samples() );
+    EXPECT_EQ( 0u, node1_.AckLatency().Count() );
+}
+
+TEST_F( RetransmissionTests, GivesUp )
+{
+    dropFirst_ = 100;
+    EXPECT_EQ( PublishResponse::TIMEOUT, PumpUntilDone( [ & ]() { return node1_.PublishReliable( "topic", { 0x01 }, 2 ); } ) );
+    EXPECT_EQ( 3u, sent_ );
+    EXPECT_EQ( 0u, received );
+}
+
+}  // namespace
@@ -0,0 +1,60 @@
+/**
+ * \file    StarNetworkTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "StarNetwork.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+using namespace esf_sim;
+
+namespace
+{
+typedef StarNetwork<EmbeddedSerialFiller, EmbeddedSerialFiller> Network;
+
+class StarNetworkTests : public ::testing::Test
+{
+   protected:
+    StarNetworkTests() {}
+
+    virtual ~StarNetworkTests() {}
+
+    ChannelModel model_;
+    Traffic traffic_;
+};
+
+TEST_F( StarNetworkTests, SixtyFourSensors )
+{
+    model_.baud = 115200;
+    model_.latency = 500;
+    Network network( 64, model_, 1, traffic_ );
+    network.Run( 200, 1 );
+    network.Flush();
+
+    StarStats stats = network.Stats();
+    EXPECT_EQ( 128u, network.Nodes() );
+    EXPECT_EQ( 64u * 20, stats.readingsSent );
+    EXPECT_EQ( stats.readingsSent, stats.readingsReceived );
+    EXPECT_EQ( 64u * 2, stats.commandsSent );
+    EXPECT_EQ( stats.commandsSent, stats.commandsReceived );
+}
+
+TEST_F( StarNetworkTests, ThreadsShareTheStatics )
+{
+    // Every node has the same Config, so all the threads take the same lock and frames.
+    uint32_t misses = EmbeddedSerialFiller::Frames().Misses();
+    Network network( 64, model_, 1, traffic_ );
+    network.Run( 100, 4 );
+    network.Flush();
+
+    StarStats stats = network.Stats();
+    EXPECT_EQ( stats.readingsSent, stats.readingsReceived );
+    EXPECT_EQ( stats.commandsSent, stats.commandsReceived );
+    // Two frames at most for each thread in GiveRxData(), within the default eight.
+    EXPECT_EQ( misses, EmbeddedSerialFiller::Frames().Misses() );
+}
+
+}  // namespace
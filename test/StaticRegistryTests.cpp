@@ -0,0 +1,142 @@
+/**
+ * \file    StaticRegistryTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/CobsTranscoder.h"
+#include "EmbeddedSerialFiller/StaticRegistry.h"
+#include "EmbeddedSerialFiller/Utilities.h"
+#include "TwoNodeFixture.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+struct ImuSample
+{
+    int16_t x;
+    int16_t y;
+    int16_t z;
+};
+
+struct Heartbeat
+{
+    uint32_t uptime;
+};
+
+static ImuSample lastImu;
+static int imuCount = 0;
+void OnImu( const ImuSample& sample )
+{
+    lastImu = sample;
+    ++imuCount;
+}
+
+static int heartbeatCount = 0;
+void OnHeartbeat( const Heartbeat& ) { ++heartbeatCount; }
+
+typedef StaticTopic<0, ImuSample, &OnImu> Imu;
+typedef StaticTopic<1, Heartbeat, &OnHeartbeat> Beat;
+typedef StaticTopic<2, Heartbeat> Unhandled;
+typedef StaticRegistry<Imu, Beat, Unhandled> Registry;
+
+static_assert( Registry::Contains<Beat>::value, "" );
+static_assert( !Registry::Contains<StaticTopic<3, Heartbeat>>::value, "" );
+
+class StaticRegistryTests : public esf_test::TwoNodeFixture
+{
+   protected:
+    StaticRegistryTests()
+    {
+        imuCount = 0;
+        heartbeatCount = 0;
+        Registry::Attach( node2_ );
+    }
+
+    StatusCode DeliverOne() { return Deliver( toNode2_, node2_ ); }
+
+    virtual ~StaticRegistryTests() {}
+};
+
+TEST_F( StaticRegistryTests, DispatchedToHandler )
+{
+    ImuSample sample = { 1, -2, 3 };
+    Registry::Publish<Imu>( node1_, sample );
+    ASSERT_EQ( 1u, toNode2_.size() );
+
+    // Type, packet ID, static topic ID, payload and CRC.
+    ByteArray decoded;
+    CobsTranscoder::Decode( toNode2_.front(), decoded );
+    EXPECT_EQ( 3u + sizeof( ImuSample ) + 2u, decoded.size() );
+    EXPECT_EQ( ESF_STATIC_TOPIC_FLAG | Imu::ID, decoded[ 2 ] );
+
+    EXPECT_EQ( StatusCode::SUCCESS, DeliverOne() );
+    EXPECT_EQ( 1, imuCount );
+    EXPECT_EQ( 0, heartbeatCount );
+    EXPECT_EQ( -2, lastImu.y );
+
+    Registry::Publish<Beat>( node1_, Heartbeat{ 1000 } );
+    EXPECT_EQ( StatusCode::SUCCESS, DeliverOne() );
+    EXPECT_EQ( 1, heartbeatCount );
+}
+
+TEST_F( StaticRegistryTests, UnhandledTopic )
+{
+    Registry::Publish<Unhandled>( node1_, Heartbeat{ 1000 } );
+    EXPECT_EQ( StatusCode::ERROR_UNKNOWN_TOPIC_ID, DeliverOne() );
+}
+
+TEST_F( StaticRegistryTests, WrongPayloadSize )
+{
+    uint8_t shortPayload[ 2 ] = { 0, 0 };
+    node1_.PublishStatic( Imu::ID, shortPayload, sizeof( shortPayload ) );
+    EXPECT_EQ( StatusCode::ERROR_UNKNOWN_TOPIC_ID, DeliverOne() );
+    EXPECT_EQ( 0, imuCount );
+}
+
+TEST_F( StaticRegistryTests, UnhandledTopicDoesntLoseTheRestOfTheChunk )
+{
+    Registry::Publish<Unhandled>( node1_, Heartbeat{ 1000 } );
+    Registry::Publish<Beat>( node1_, Heartbeat{ 1000 } );
+    ByteArray chunk;
+    for( const ByteArray& frame : toNode2_ )
+    {
+        chunk.insert( chunk.end(), frame.begin(), frame.end() );
+    }
+    EXPECT_EQ( StatusCode::ERROR_UNKNOWN_TOPIC_ID, node2_.GiveRxData( chunk ) );
+    EXPECT_EQ( 1, heartbeatCount );
+}
+
+TEST_F( StaticRegistryTests, NoRegistryAttached )
+{
+    node2_.AttachRegistry( nullptr );
+    Registry::Publish<Beat>( node1_, Heartbeat{ 1000 } );
+    EXPECT_EQ( StatusCode::ERROR_UNKNOWN_TOPIC_ID, DeliverOne() );
+}
+
+TEST_F( StaticRegistryTests, NoRoomForTheTopicId )
+{
+    // A BROADCAST with no topic at all, whose CRC happens to look like a static topic ID.
+    ByteArray packet;
+    for( int packetId = 0; packetId < 0x100; ++packetId )
+    {
+        packet.clear();
+        packet.push_back( static_cast<uint8_t>( PacketType::BROADCAST ) );
+        packet.push_back( static_cast<uint8_t>( packetId ) );
+        Utilities::AddCrc( packet );
+        if( ( packet[ 2 ] & ESF_STATIC_TOPIC_FLAG ) == ESF_STATIC_TOPIC_FLAG )
+        {
+            break;
+        }
+    }
+    ASSERT_EQ( ESF_STATIC_TOPIC_FLAG, packet[ 2 ] & ESF_STATIC_TOPIC_FLAG );
+    ByteArray frame;
+    CobsTranscoder::Encode( packet, frame );
+    EXPECT_EQ( StatusCode::ERROR_NOT_ENOUGH_BYTES, node2_.GiveRxData( frame ) );
+    EXPECT_EQ( 0, imuCount );
+    EXPECT_EQ( 0, heartbeatCount );
+}
+
+}  // namespace
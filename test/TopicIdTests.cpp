@@ -0,0 +1,180 @@
+/**
+ * \file    TopicIdTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/CobsTranscoder.h"
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "EmbeddedSerialFiller/Utilities.h"
+#include "TwoNodeFixture.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+static ByteArray savedData;
+static size_t received = 0;
+auto dataStore = []( ByteArray& data ) {
+    savedData = data;
+    ++received;
+};
+
+const ByteArray SAMPLE( { 0x01, 0x02, 0x03, 0x04 } );
+
+class TopicIdTests : public esf_test::TwoNodeFixture
+{
+   protected:
+    TopicDictionary dictionary1_;
+    TopicDictionary dictionary2_;
+
+    TopicIdTests()
+    {
+        savedData.clear();
+        received = 0;
+        node1_.AttachDictionary( &dictionary1_ );
+        node2_.AttachDictionary( &dictionary2_ );
+        node2_.Subscribe( "telemetry/temp", etl::delegate<void( ByteArray & data )>( dataStore ) );
+    }
+
+    virtual ~TopicIdTests() {}
+};
+
+TEST_F( TopicIdTests, AnnouncedThenSentById )
+{
+    node1_.Publish( "telemetry/temp", SAMPLE );
+    ASSERT_EQ( 2u, toNode2_.size() );
+    EXPECT_EQ( static_cast<uint8_t>( PacketType::TOPIC_ANNOUNCE ), Decode( toNode2_[ 0 ] )[ 0 ] );
+    // Until confirmed the topic string is still sent.
+    size_t stringSize = Decode( toNode2_[ 1 ] ).size();
+    Pump();
+    EXPECT_EQ( 1u, received );
+
+    node1_.Publish( "telemetry/temp", SAMPLE );
+    ASSERT_EQ( 1u, toNode2_.size() );
+    ByteArray decoded = Decode( toNode2_[ 0 ] );
+    // Type, packet ID, topic ID, data and CRC.
+    EXPECT_EQ( 3u + SAMPLE.size() + 2u, decoded.size() );
+    EXPECT_EQ( stringSize - Topic( "telemetry/temp" ).size(), decoded.size() );
+    EXPECT_EQ( TopicDictionary::TOPIC_ID_FLAG, decoded[ 2 ] & TopicDictionary::TOPIC_ID_FLAG );
+    Pump();
+    EXPECT_EQ( 2u, received );
+    EXPECT_EQ( SAMPLE, savedData );
+    EXPECT_EQ( StatusCode::SUCCESS, lastStatus_ );
+}
+
+TEST_F( TopicIdTests, FallsBackToStrings )
+{
+    node2_.AttachDictionary( nullptr );
+    for( int i = 0; i < ESF_TOPIC_ANNOUNCE_RETRY; ++i )
+    {
+        node1_.Publish( "telemetry/temp", SAMPLE );
+        Pump();
+    }
+    EXPECT_EQ( static_cast<size_t>( ESF_TOPIC_ANNOUNCE_RETRY ), received );
+    // The announcements are ignored.
+    EXPECT_EQ( StatusCode::SUCCESS, lastStatus_ );
+
+    // Announced again now and then, in case the remote node gains a dictionary.
+    node1_.Publish( "telemetry/temp", SAMPLE );
+    EXPECT_EQ( 2u, toNode2_.size() );
+}
+
+TEST_F( TopicIdTests, AnnounceAndPublishInOneChunk )
+{
+    node2_.AttachDictionary( nullptr );
+    node1_.Publish( "telemetry/temp", SAMPLE );
+    ASSERT_EQ( 2u, toNode2_.size() );
+    ByteArray chunk( toNode2_[ 0 ] );
+    chunk.insert( chunk.end(), toNode2_[ 1 ].begin(), toNode2_[ 1 ].end() );
+    toNode2_.clear();
+
+    EXPECT_EQ( StatusCode::SUCCESS, node2_.GiveRxData( chunk ) );
+    EXPECT_EQ( 1u, received );
+    EXPECT_EQ( SAMPLE, savedData );
+    EXPECT_TRUE( toNode1_.empty() );
+}
+
+TEST_F( TopicIdTests, UnknownIdDoesntLoseTheRestOfTheChunk )
+{
+    node1_.Publish( "telemetry/temp", SAMPLE );
+    Pump();
+    dictionary2_.Reset();
+
+    node1_.Publish( "telemetry/temp", SAMPLE );
+    node1_.Publish( "other", SAMPLE );
+    node2_.Subscribe( "other", etl::delegate<void( ByteArray & data )>( dataStore ) );
+    ByteArray chunk;
+    for( auto& frame : toNode2_ )
+    {
+        chunk.insert( chunk.end(), frame.begin(), frame.end() );
+    }
+    toNode2_.clear();
+    EXPECT_EQ( StatusCode::ERROR_UNKNOWN_TOPIC_ID, node2_.GiveRxData( chunk ) );
+    // The message on the forgotten ID is lost, the one after it isn't.
+    EXPECT_EQ( 2u, received );
+}
+
+TEST_F( TopicIdTests, UnrecognisedPacketDoesntLoseTheRestOfTheChunk )
+{
+    ByteArray unknown( { 0x3F, 0x01 } );
+    Utilities::AddCrc( unknown );
+    ByteArray chunk;
+    CobsTranscoder::Encode( unknown, chunk );
+    node1_.AttachDictionary( nullptr );
+    node1_.Publish( "telemetry/temp", SAMPLE );
+    chunk.insert( chunk.end(), toNode2_[ 0 ].begin(), toNode2_[ 0 ].end() );
+    toNode2_.clear();
+
+    EXPECT_EQ( StatusCode::ERROR_UNRECOGNISED_PACKET_TYPE, node2_.GiveRxData( chunk ) );
+    EXPECT_EQ( 1u, received );
+    EXPECT_EQ( SAMPLE, savedData );
+}
+
+TEST_F( TopicIdTests, UnknownIdIsRejectedAndReannounced )
+{
+    node1_.Publish( "telemetry/temp", SAMPLE );
+    Pump();
+
+    // The receiver restarts, forgetting the ID.
+    dictionary2_.Reset();
+    node1_.Publish( "telemetry/temp", SAMPLE );
+    Pump();
+    EXPECT_EQ( StatusCode::ERROR_UNKNOWN_TOPIC_ID, lastStatus_ );
+    EXPECT_EQ( 1u, received );
+
+    node1_.Publish( "telemetry/temp", SAMPLE );
+    EXPECT_EQ( static_cast<uint8_t>( PacketType::TOPIC_ANNOUNCE ), Decode( toNode2_[ 0 ] )[ 0 ] );
+    Pump();
+    EXPECT_EQ( 2u, received );
+
+    node1_.Publish( "telemetry/temp", SAMPLE );
+    EXPECT_EQ( 1u, toNode2_.size() );
+    Pump();
+    EXPECT_EQ( 3u, received );
+}
+
+TEST_F( TopicIdTests, IdBeyondTheDictionaryIsRejected )
+{
+    // An announcement from a node with a larger ESF_MAX_TOPIC_IDS.
+    const uint8_t topicId = ESF_MAX_TOPIC_IDS + 4;
+    const Topic topic( "telemetry/temp" );
+    ByteArray announce;
+    announce.push_back( static_cast<uint8_t>( PacketType::TOPIC_ANNOUNCE ) );
+    announce.push_back( topicId );
+    announce.push_back( static_cast<uint8_t>( topic.size() ) );
+    announce.insert( announce.end(), topic.begin(), topic.end() );
+    Utilities::AddCrc( announce );
+    ByteArray frame;
+    CobsTranscoder::Encode( announce, frame );
+
+    EXPECT_EQ( StatusCode::SUCCESS, node2_.GiveRxData( frame ) );
+    EXPECT_EQ( nullptr, dictionary2_.RxResolve( topicId ) );
+    ASSERT_EQ( 1u, toNode1_.size() );
+    ByteArray ack = Decode( toNode1_[ 0 ] );
+    EXPECT_EQ( static_cast<uint8_t>( PacketType::TOPIC_ACK ), ack[ 0 ] );
+    EXPECT_EQ( TopicDictionary::TOPIC_ID_FLAG | topicId, ack[ 1 ] );
+}
+
+}  // namespace
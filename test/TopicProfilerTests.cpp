@@ -0,0 +1,149 @@
+/**
+ * \file    TopicProfilerTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "EmbeddedSerialFiller/TopicProfiler.h"
+#include "TwoNodeFixture.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+class TopicProfilerTests : public ::testing::Test
+{
+   protected:
+    TopicProfiler profiler_;
+
+    TopicProfilerTests() {}
+    virtual ~TopicProfilerTests() {}
+};
+
+TEST_F( TopicProfilerTests, CountsMessages )
+{
+    EXPECT_EQ( 0u, profiler_.Topics() );
+    TopicProfiler::Profile* a = profiler_.Message( "a", 10, 100 );
+    TopicProfiler::Profile* b = profiler_.Message( "b", 20, 150 );
+    ASSERT_NE( nullptr, a );
+    ASSERT_NE( nullptr, b );
+    EXPECT_EQ( a, profiler_.Message( "a", 5, 300 ) );
+    profiler_.Callback( *a, 7 );
+    profiler_.Callback( *a, 3 );
+
+    EXPECT_EQ( 2u, profiler_.Topics() );
+    EXPECT_EQ( 2u, a->messages );
+    EXPECT_EQ( 15u, a->bytes );
+    EXPECT_EQ( 2u, a->deliveries );
+    EXPECT_EQ( 10u, a->ticks );
+    EXPECT_EQ( 7u, a->maxTicks );
+    EXPECT_EQ( 0u, b->deliveries );
+    EXPECT_EQ( 200u, profiler_.Elapsed() );
+}
+
+TEST_F( TopicProfilerTests, Overflows )
+{
+    for( size_t i = 0; i < ESF_PROFILER_TOPICS; ++i )
+    {
+        const char name[] = { static_cast<char>( 'a' + i ), '\0' };
+        EXPECT_NE( nullptr, profiler_.Message( name, 1, 0 ) );
+    }
+    EXPECT_EQ( nullptr, profiler_.Message( "overflow", 1, 0 ) );
+    EXPECT_EQ( 1u, profiler_.Overflows() );
+
+    profiler_.Reset();
+    EXPECT_EQ( 0u, profiler_.Topics() );
+    EXPECT_EQ( 0u, profiler_.Overflows() );
+    TopicProfiler::Profile* profile = profiler_.Message( "a", 1, 0 );
+    ASSERT_NE( nullptr, profile );
+    EXPECT_EQ( 1u, profile->messages );
+}
+
+TEST_F( TopicProfilerTests, Percentiles )
+{
+    TopicProfiler::Profile* profile = profiler_.Message( "a", 1, 0 );
+    for( uint32_t i = 0; i < 90; ++i )
+    {
+        profiler_.Callback( *profile, 10 );
+    }
+    for( uint32_t i = 0; i < 10; ++i )
+    {
+        profiler_.Callback( *profile, 1000 );
+    }
+    EXPECT_EQ( 90u, profile->histogram[ 4 ] );
+    EXPECT_EQ( 10u, profile->histogram[ 10 ] );
+    // 10 is in the bucket up to 15, 1000 in the one up to 1023, capped by the longest.
+    EXPECT_EQ( 15u, profile->Percentile( 50 ) );
+    EXPECT_EQ( 15u, profile->Percentile( 90 ) );
+    EXPECT_EQ( 1000u, profile->Percentile( 99 ) );
+    EXPECT_EQ( 1000u, profile->maxTicks );
+}
+
+TEST_F( TopicProfilerTests, Hottest )
+{
+    const uint32_t ticks[] = { 5, 50, 1, 20, 40 };
+    for( size_t i = 0; i < 5; ++i )
+    {
+        const char name[] = { static_cast<char>( 'a' + i ), '\0' };
+        profiler_.Callback( *profiler_.Message( name, 1, 0 ), ticks[ i ] );
+    }
+    const TopicProfiler::Profile* hottest[ 3 ];
+    ASSERT_EQ( 3u, profiler_.Hottest( hottest, 3 ) );
+    EXPECT_EQ( "b", hottest[ 0 ]->topic );
+    EXPECT_EQ( "e", hottest[ 1 ]->topic );
+    EXPECT_EQ( "d", hottest[ 2 ]->topic );
+
+    const TopicProfiler::Profile* all[ 8 ];
+    ASSERT_EQ( 5u, profiler_.Hottest( all, 8 ) );
+    EXPECT_EQ( "c", all[ 4 ]->topic );
+}
+
+#if defined( ESF_TOPIC_PROFILER )
+class TopicProfilerNodeTests : public esf_test::TwoNodeFixture
+{
+   protected:
+    TopicProfiler profiler_;
+    int received_;
+
+    TopicProfilerNodeTests() : received_( 0 )
+    {
+        node2_.AttachProfiler( &profiler_ );
+    }
+
+    virtual ~TopicProfilerNodeTests() {}
+
+   public:
+    void Receive( ByteArray& ) { ++received_; }
+};
+
+TEST_F( TopicProfilerNodeTests, ProfilesDispatch )
+{
+    auto callback = etl::delegate<void( ByteArray& )>::create<TopicProfilerNodeTests, &TopicProfilerNodeTests::Receive>( *this );
+    node2_.Subscribe( "sensor/imu", callback );
+    node2_.Subscribe( "sensor/*", callback );
+    for( int i = 0; i < 5; ++i )
+    {
+        node1_.Publish( "sensor/imu", ByteArray( 12, 0x01 ) );
+    }
+    node1_.Publish( "unheard", ByteArray( 3, 0x02 ) );
+    Pump();
+
+    EXPECT_EQ( 10, received_ );
+    ASSERT_EQ( 2u, profiler_.Topics() );
+    EXPECT_EQ( "sensor/imu", profiler_[ 0 ].topic );
+    EXPECT_EQ( 5u, profiler_[ 0 ].messages );
+    EXPECT_EQ( 60u, profiler_[ 0 ].bytes );
+    EXPECT_EQ( 10u, profiler_[ 0 ].deliveries );
+    EXPECT_EQ( "unheard", profiler_[ 1 ].topic );
+    EXPECT_EQ( 0u, profiler_[ 1 ].deliveries );
+
+    node2_.AttachProfiler( nullptr );
+    node1_.Publish( "sensor/imu", ByteArray( 12, 0x01 ) );
+    Pump();
+    EXPECT_EQ( 5u, profiler_[ 0 ].messages );
+}
+#endif
+
+}  // namespace
@@ -0,0 +1,120 @@
+/**
+ * \file    TopicTableTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include <string>
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+static int calls = 0;
+auto callback = []( ByteArray& ) { ++calls; };
+
+class TopicTableTests : public ::testing::Test
+{
+   protected:
+    TopicTable table_;
+
+    TopicTableTests() { calls = 0; }
+
+    static Topic Name( size_t i ) { return Topic( ( "topic" + std::to_string( i ) ).c_str() ); }
+
+    virtual ~TopicTableTests() {}
+};
+
+TEST_F( TopicTableTests, FindAfterAdd )
+{
+    for( size_t i = 0; i < ESF_MAX_SUBSCRIBERS; ++i )
+    {
+        EXPECT_NE( TopicTable::INVALID_ID, table_.Add( Name( i ), etl::delegate<void( ByteArray & data )>( callback ) ) );
+    }
+    EXPECT_EQ( static_cast<size_t>( ESF_MAX_SUBSCRIBERS ), table_.Size() );
+    for( size_t i = 0; i < ESF_MAX_SUBSCRIBERS; ++i )
+    {
+        const TopicTable::SubscriberList* subscribers = table_.Find( Name( i ) );
+        ASSERT_NE( nullptr, subscribers );
+        EXPECT_EQ( 1u, subscribers->size() );
+    }
+    EXPECT_EQ( nullptr, table_.Find( "unknown" ) );
+
+    // No room for another topic.
+    EXPECT_EQ( TopicTable::INVALID_ID, table_.Add( "unknown", etl::delegate<void( ByteArray & data )>( callback ) ) );
+}
+
+TEST_F( TopicTableTests, SubscribersShareATopic )
+{
+    uint32_t id1 = table_.Add( "topic", etl::delegate<void( ByteArray & data )>( callback ) );
+    uint32_t id2 = table_.Add( "topic", etl::delegate<void( ByteArray & data )>( callback ) );
+    EXPECT_NE( id1, id2 );
+    EXPECT_EQ( 1u, table_.Size() );
+    EXPECT_EQ( 2u, table_.Find( "topic" )->size() );
+
+    EXPECT_TRUE( table_.Remove( id1 ) );
+    EXPECT_FALSE( table_.Remove( id1 ) );
+    EXPECT_EQ( 1u, table_.Find( "topic" )->size() );
+
+    // The topic goes with its last subscriber.
+    EXPECT_TRUE( table_.Remove( id2 ) );
+    EXPECT_EQ( nullptr, table_.Find( "topic" ) );
+    EXPECT_EQ( 0u, table_.Size() );
+}
+
+TEST_F( TopicTableTests, RemovalKeepsOtherTopicsReachable )
+{
+    uint32_t ids[ ESF_MAX_SUBSCRIBERS ];
+    for( size_t i = 0; i < ESF_MAX_SUBSCRIBERS; ++i )
+    {
+        ids[ i ] = table_.Add( Name( i ), etl::delegate<void( ByteArray & data )>( callback ) );
+    }
+    // Churn the table, so removed slots are both left behind and reused.
+    for( int round = 0; round < 100; ++round )
+    {
+        for( size_t i = 0; i < ESF_MAX_SUBSCRIBERS; i += 2 )
+        {
+            EXPECT_TRUE( table_.Remove( ids[ i ] ) );
+        }
+        for( size_t i = 1; i < ESF_MAX_SUBSCRIBERS; i += 2 )
+        {
+            EXPECT_NE( nullptr, table_.Find( Name( i ) ) );
+        }
+        for( size_t i = 0; i < ESF_MAX_SUBSCRIBERS; i += 2 )
+        {
+            ids[ i ] = table_.Add( Name( i + 100 * round ), etl::delegate<void( ByteArray & data )>( callback ) );
+            EXPECT_NE( TopicTable::INVALID_ID, ids[ i ] );
+        }
+    }
+}
+
+TEST_F( TopicTableTests, ChurnLeavesNoMarkersBehind )
+{
+    uint32_t ids[ ESF_MAX_SUBSCRIBERS ];
+    for( int round = 0; round < 100; ++round )
+    {
+        for( size_t i = 0; i < ESF_MAX_SUBSCRIBERS; ++i )
+        {
+            ids[ i ] = table_.Add( Name( i + ESF_MAX_SUBSCRIBERS * round ), etl::delegate<void( ByteArray & data )>( callback ) );
+            ASSERT_NE( TopicTable::INVALID_ID, ids[ i ] );
+        }
+        // Remove in a different order to the adds, so entries are shifted back over the gaps.
+        for( size_t i = 0; i < ESF_MAX_SUBSCRIBERS; ++i )
+        {
+            size_t j = ( i * 7 + round ) % ESF_MAX_SUBSCRIBERS;
+            EXPECT_TRUE( table_.Remove( ids[ j ] ) );
+            EXPECT_EQ( nullptr, table_.Find( Name( j + ESF_MAX_SUBSCRIBERS * round ) ) );
+        }
+        EXPECT_EQ( 0u, table_.Size() );
+    }
+    // An empty table ends every lookup at its home slot, however many topics have come and gone.
+    for( size_t i = 0; i < 100; ++i )
+    {
+        EXPECT_EQ( 1u, table_.ProbeLength( Name( i ) ) );
+    }
+}
+
+}  // namespace
@@ -0,0 +1,116 @@
+/**
+ * \file    TopicTrieTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#include <string>
+
+#include "EmbeddedSerialFiller/TopicTrie.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+auto callback = []( ByteArray& ) {};
+
+class TopicTrieTests : public ::testing::Test
+{
+   protected:
+    TopicTrie trie_;
+    const TopicTable::SubscriberList* matches_[ ESF_MAX_WILDCARDS ];
+
+    uint32_t Add( const Topic& pattern ) { return trie_.Add( pattern, etl::delegate<void( ByteArray & data )>( callback ) ); }
+
+    size_t Match( const Topic& topic ) { return trie_.Match( topic, matches_ ); }
+
+    virtual ~TopicTrieTests() {}
+};
+
+TEST_F( TopicTrieTests, IsPattern )
+{
+    EXPECT_TRUE( TopicTrie::IsPattern( "motor/*" ) );
+    EXPECT_TRUE( TopicTrie::IsPattern( "*" ) );
+    EXPECT_FALSE( TopicTrie::IsPattern( "motor/" ) );
+    EXPECT_FALSE( TopicTrie::IsPattern( "" ) );
+}
+
+TEST_F( TopicTrieTests, PrefixMatch )
+{
+    uint32_t id = Add( "motor/*" );
+    EXPECT_NE( TopicTable::INVALID_ID, id );
+    EXPECT_EQ( 6u, trie_.Nodes() );
+
+    EXPECT_EQ( 1u, Match( "motor/left" ) );
+    EXPECT_EQ( 1u, matches_[ 0 ]->size() );
+    EXPECT_EQ( id, matches_[ 0 ]->front().id_ );
+    EXPECT_EQ( 1u, Match( "motor/" ) );
+    EXPECT_EQ( 0u, Match( "motor" ) );
+    EXPECT_EQ( 0u, Match( "motors" ) );
+    EXPECT_EQ( 0u, Match( "servo/left" ) );
+}
+
+TEST_F( TopicTrieTests, NestedPatterns )
+{
+    Add( "*" );
+    Add( "motor/*" );
+    Add( "motor/left/*" );
+    Add( "mode*" );
+
+    // Shares "mo" with "motor/".
+    EXPECT_EQ( 13u, trie_.Nodes() );
+
+    EXPECT_EQ( 3u, Match( "motor/left/speed" ) );
+    EXPECT_EQ( 2u, Match( "motor/right" ) );
+    EXPECT_EQ( 2u, Match( "mode" ) );
+    EXPECT_EQ( 1u, Match( "servo" ) );
+}
+
+TEST_F( TopicTrieTests, SubscribersShareAPattern )
+{
+    uint32_t id1 = Add( "motor/*" );
+    uint32_t id2 = Add( "motor/*" );
+    EXPECT_NE( id1, id2 );
+    EXPECT_EQ( 6u, trie_.Nodes() );
+    ASSERT_EQ( 1u, Match( "motor/left" ) );
+    EXPECT_EQ( 2u, matches_[ 0 ]->size() );
+
+    EXPECT_TRUE( trie_.Remove( id1 ) );
+    EXPECT_FALSE( trie_.Remove( id1 ) );
+    EXPECT_EQ( 1u, Match( "motor/left" ) );
+    EXPECT_TRUE( trie_.Remove( id2 ) );
+    EXPECT_EQ( 0u, Match( "motor/left" ) );
+
+    // Not one of ours.
+    EXPECT_FALSE( trie_.Remove( 0x100 ) );
+}
+
+TEST_F( TopicTrieTests, NodesReclaimed )
+{
+    uint32_t id = Add( "motor/*" );
+    Add( "servo/*" );
+    EXPECT_EQ( 12u, trie_.Nodes() );
+
+    EXPECT_TRUE( trie_.Remove( id ) );
+    EXPECT_EQ( 6u, trie_.Nodes() );
+    EXPECT_EQ( 0u, Match( "motor/left" ) );
+    EXPECT_EQ( 1u, Match( "servo/left" ) );
+
+    EXPECT_TRUE( trie_.RemovePattern( "servo/*" ) );
+    EXPECT_FALSE( trie_.RemovePattern( "servo/*" ) );
+    EXPECT_EQ( 0u, trie_.Nodes() );
+}
+
+TEST_F( TopicTrieTests, Full )
+{
+    for( size_t i = 0; i < ESF_MAX_WILDCARDS; ++i )
+    {
+        EXPECT_NE( TopicTable::INVALID_ID, Add( Topic( ( std::to_string( i ) + "*" ).c_str() ) ) );
+    }
+    EXPECT_EQ( TopicTable::INVALID_ID, Add( "motor/*" ) );
+
+    EXPECT_EQ( static_cast<size_t>( ESF_MAX_WILDCARDS ), trie_.Nodes() );
+}
+
+}  // namespace
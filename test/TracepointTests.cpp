@@ -0,0 +1,116 @@
+/**
+ * \file    TracepointTests.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+// The tracepoints go to a hook of this file's own, so it must be defined before anything includes Tracepoints.h.
+// The nodes here have a Config of their own, so they don't share code with nodes built without the hook.
+
+#include <deque>
+#include <string>
+#include <vector>
+
+struct TraceRecord
+{
+    std::string probe;
+    const void* node;
+};
+
+static std::vector<TraceRecord> traces;
+
+template <typename Arg1, typename Arg2>
+void Trace( const char* probe, const void* node, Arg1, Arg2 )
+{
+    traces.push_back( { probe, node } );
+}
+
+#define ESF_TRACE( probe, node, arg1, arg2 ) Trace( #probe, node, arg1, arg2 )
+
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "gtest/gtest.h"
+
+using namespace esf;
+
+namespace
+{
+struct TraceConfig : DefaultConfig
+{
+};
+typedef BasicEmbeddedSerialFiller<TraceConfig> TraceNode;
+
+class TracepointTests : public ::testing::Test
+{
+   protected:
+    TraceNode node1_;
+    TraceNode node2_;
+    std::deque<TraceNode::ByteArray> toNode2_;
+
+    TracepointTests()
+    {
+        traces.clear();
+        node1_.txDataReady_ = etl::delegate<void( const TraceNode::ByteArray& )>::create<TracepointTests, &TracepointTests::txHandler1>( *this );
+        node2_.txDataReady_ = etl::delegate<void( const TraceNode::ByteArray& )>::create<TracepointTests, &TracepointTests::txHandler2>( *this );
+        node2_.Subscribe( "topic", etl::delegate<void( TraceNode::ByteArray& )>::create<TracepointTests, &TracepointTests::Receive>( *this ) );
+    }
+
+    virtual ~TracepointTests() {}
+
+   public:
+    void Receive( TraceNode::ByteArray& ) { traces.push_back( { "received", &node2_ } ); }
+
+   protected:
+    void txHandler1( const TraceNode::ByteArray& data ) { toNode2_.push_back( data ); }
+    // The ACKs aren't needed.
+    void txHandler2( const TraceNode::ByteArray& ) {}
+
+    void Pump()
+    {
+        while( !toNode2_.empty() )
+        {
+            TraceNode::ByteArray frame = toNode2_.front();
+            toNode2_.pop_front();
+            node2_.GiveRxData( frame );
+        }
+    }
+
+    // The probes hit by node, in order.
+    static std::vector<std::string> Probes( const TraceNode& node )
+    {
+        std::vector<std::string> probes;
+        for( auto& trace : traces )
+        {
+            if( trace.node == &node )
+            {
+                probes.push_back( trace.probe );
+            }
+        }
+        return probes;
+    }
+};
+
+TEST_F( TracepointTests, ReceiveAndDispatch )
+{
+    node1_.Publish( "topic", TraceNode::ByteArray( 4, 0x01 ) );
+    EXPECT_EQ( std::vector<std::string>( { "tx" } ), Probes( node1_ ) );
+    Pump();
+    EXPECT_EQ( std::vector<std::string>( { "frame", "decoded", "crc", "callback_entry", "received", "callback_exit" } ), Probes( node2_ ) );
+}
+
+TEST_F( TracepointTests, AckSent )
+{
+    // Not waiting, just to have node 2 acknowledge the packet.
+    node1_.PublishWait( "topic", TraceNode::ByteArray( 4, 0x01 ), 0 );
+    Pump();
+    EXPECT_EQ( std::vector<std::string>( { "frame", "decoded", "crc", "ack_sent", "tx", "callback_entry", "received", "callback_exit" } ), Probes( node2_ ) );
+}
+
+TEST_F( TracepointTests, BadCrc )
+{
+    // [ 0x01, 0x02 ] and a wrong CRC, COBS encoded.
+    TraceNode::ByteArray corrupt( { 0x05, 0x01, 0x02, 0x03, 0x04, 0x00 } );
+    node2_.GiveRxData( corrupt );
+    EXPECT_EQ( std::vector<std::string>( { "frame", "decoded", "crc" } ), Probes( node2_ ) );
+}
+
+}  // namespace
@@ -0,0 +1,116 @@
+/**
+ * \file    TwoNodeFixture.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_TWO_NODE_FIXTURE_H
+#define ESF_TWO_NODE_FIXTURE_H
+
+#include <deque>
+#include <mutex>
+
+#include "EmbeddedSerialFiller/CobsTranscoder.h"
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+#include "gtest/gtest.h"
+
+namespace esf_test
+{
+/// \brief Two nodes joined by queues, so the test controls when (and if) each frame arrives.
+/// \details
+/// Frames may be sent from any thread, the queues are only touched with mutex_ held. It is released while a frame
+/// is given to a node, so the node's replies can be queued.
+class TwoNodeFixture : public ::testing::Test
+{
+   protected:
+    esf::EmbeddedSerialFiller node1_;
+    esf::EmbeddedSerialFiller node2_;
+    std::mutex mutex_;
+    std::deque<esf::ByteArray> toNode1_;
+    std::deque<esf::ByteArray> toNode2_;
+    /// \brief      The last error a node returned from a frame given to it by Deliver().
+    esf::StatusCode lastStatus_;
+
+    TwoNodeFixture() : lastStatus_( esf::StatusCode::SUCCESS )
+    {
+        node1_.txDataReady_ = etl::delegate<void( const esf::ByteQueue& )>::create<TwoNodeFixture, &TwoNodeFixture::txHandler1>( *this );
+        node2_.txDataReady_ = etl::delegate<void( const esf::ByteQueue& )>::create<TwoNodeFixture, &TwoNodeFixture::txHandler2>( *this );
+    }
+
+    virtual ~TwoNodeFixture() {}
+
+    /// \brief      Sees every frame node 1 sends, with mutex_ held.
+    /// \returns    False to lose the frame.
+    virtual bool FromNode1( const esf::ByteArray& /* frame */ ) { return true; }
+
+    /// \brief      Delivers everything queued, in both directions, until the link is idle.
+    void Pump()
+    {
+        while( Pending( toNode1_ ) || Pending( toNode2_ ) )
+        {
+            Deliver( toNode2_, node2_ );
+            Deliver( toNode1_, node1_ );
+        }
+    }
+
+    /// \brief      Gives the oldest frame in \p queue, if there is one, to \p node.
+    /// \returns    What the node returned, SUCCESS if there was nothing to give it.
+    esf::StatusCode Deliver( std::deque<esf::ByteArray>& queue, esf::EmbeddedSerialFiller& node )
+    {
+        std::unique_lock<std::mutex> lock( mutex_ );
+        if( queue.empty() )
+        {
+            return esf::StatusCode::SUCCESS;
+        }
+        esf::ByteArray frame = queue.front();
+        queue.pop_front();
+        lock.unlock();
+        esf::StatusCode result = node.GiveRxData( frame );
+        if( result != esf::StatusCode::SUCCESS )
+        {
+            lastStatus_ = result;
+        }
+        return result;
+    }
+
+    size_t Pending( std::deque<esf::ByteArray>& queue )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        return queue.size();
+    }
+
+    esf::ByteArray Pop( std::deque<esf::ByteArray>& queue )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        esf::ByteArray frame = queue.front();
+        queue.pop_front();
+        return frame;
+    }
+
+    static esf::ByteArray Decode( const esf::ByteArray& frame )
+    {
+        esf::ByteArray decoded;
+        esf::CobsTranscoder::Decode( frame, decoded );
+        return decoded;
+    }
+
+   private:
+    void txHandler1( const esf::ByteQueue& data )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        if( FromNode1( data ) )
+        {
+            toNode2_.push_back( data );
+        }
+    }
+
+    void txHandler2( const esf::ByteQueue& data )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        toNode1_.push_back( data );
+    }
+};
+
+}  // namespace esf_test
+
+#endif  // #ifndef ESF_TWO_NODE_FIXTURE_H
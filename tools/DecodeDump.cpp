@@ -0,0 +1,211 @@
+/**
+ * \file    DecodeDump.cpp
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+// Decodes a raw UART dump (one direction of a link) on every core, with a DumpDecoder. Prints a line for each topic
+// and the frames that couldn't be decoded, and with --out writes each topic's messages, in order, to a file of its own.
+//
+// EmbeddedSerialFillerDecodeDump <dump> [--threads <count>] [--block <bytes>] [--out <directory>] [--synthesize <MB>]
+//
+// Each message in an --out file is a line: <offset in the dump> <packet type> <data in hex>. A fragment's line has
+// only its part of the message. --synthesize first writes <dump> with that many MB of frames, to try the tool out.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+
+#include "DumpDecoder.h"
+#include "EmbeddedSerialFiller/EmbeddedSerialFiller.h"
+
+using namespace esf;
+using namespace esf_tools;
+
+namespace
+{
+struct TopicOutput
+{
+    TopicOutput() : messages( 0 ), bytes( 0 ), file( nullptr ) {}
+
+    uint64_t messages;
+    uint64_t bytes;
+    FILE* file;
+};
+
+/// \returns    A file name for \p topic, its '/'s and anything else awkward made '_'.
+std::string FileName( const std::string& topic )
+{
+    std::string name = topic.empty() ? "_" : topic;
+    for( auto& c : name )
+    {
+        bool plain = ( ( c >= 'a' ) && ( c <= 'z' ) ) || ( ( c >= 'A' ) && ( c <= 'Z' ) ) || ( ( c >= '0' ) && ( c <= '9' ) ) || ( c == '-' ) || ( c == '.' );
+        c = plain ? c : '_';
+    }
+    return name + ".txt";
+}
+
+/// \brief      Appends every frame a node sends to a file.
+struct FrameWriter
+{
+    void Write( const ByteArray& frame ) { fwrite( frame.data(), 1, frame.size(), file ); }
+
+    FILE* file;
+};
+
+/// \brief      Writes \p megabytes of frames, as a node publishing a mix of topics and sizes would send them.
+bool Synthesize( const char* path, int megabytes )
+{
+    FILE* file = fopen( path, "wb" );
+    if( file == nullptr )
+    {
+        return false;
+    }
+    static const char* const TOPICS[] = { "imu", "motor/left", "motor/right", "battery", "log" };
+    FrameWriter writer = { file };
+    EmbeddedSerialFiller node;
+    node.txDataReady_ = etl::delegate<void( const ByteArray& )>::create<FrameWriter, &FrameWriter::Write>( writer );
+    ByteArray payload;
+    uint32_t random = 1;
+    while( ftell( file ) < megabytes * 1048576L )
+    {
+        random = random * 1103515245u + 12345u;
+        payload.resize( 8 + ( random >> 16 ) % 248 );
+        for( size_t i = 0; i < payload.size(); ++i )
+        {
+            payload[ i ] = static_cast<uint8_t>( ( random >> 24 ) + i );
+        }
+        node.Publish( TOPICS[ ( random >> 8 ) % 5 ], payload );
+    }
+    fclose( file );
+    return true;
+}
+
+}  // namespace
+
+int main( int argc, char** argv )
+{
+    if( argc < 2 )
+    {
+        fprintf( stderr, "No dump given, see the top of DecodeDump.cpp\n" );
+        return 2;
+    }
+    const char* path = argv[ 1 ];
+    unsigned threads = 0;
+    size_t block = 1 << 20;
+    std::string out;
+    int synthesize = 0;
+    for( int i = 2; i + 1 < argc; i += 2 )
+    {
+        std::string option = argv[ i ];
+        const char* value = argv[ i + 1 ];
+        if( option == "--threads" )
+        {
+            threads = static_cast<unsigned>( atoi( value ) );
+        }
+        else if( option == "--block" )
+        {
+            block = static_cast<size_t>( atol( value ) );
+        }
+        else if( option == "--out" )
+        {
+            out = value;
+        }
+        else if( option == "--synthesize" )
+        {
+            synthesize = atoi( value );
+        }
+        else
+        {
+            fprintf( stderr, "Unknown option %s, see the top of DecodeDump.cpp\n", option.c_str() );
+            return 2;
+        }
+    }
+
+    if( ( synthesize > 0 ) && !Synthesize( path, synthesize ) )
+    {
+        fprintf( stderr, "Couldn't write %s\n", path );
+        return 1;
+    }
+
+    int fd = open( path, O_RDONLY );
+    struct stat status;
+    if( ( fd < 0 ) || ( fstat( fd, &status ) != 0 ) )
+    {
+        fprintf( stderr, "Couldn't open %s\n", path );
+        return 1;
+    }
+    size_t size = static_cast<size_t>( status.st_size );
+    const uint8_t* dump = nullptr;
+    if( size != 0 )
+    {
+        void* mapped = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        if( mapped == MAP_FAILED )
+        {
+            fprintf( stderr, "Couldn't map %s\n", path );
+            return 1;
+        }
+        madvise( mapped, size, MADV_SEQUENTIAL );
+        dump = static_cast<const uint8_t*>( mapped );
+    }
+    close( fd );
+
+    std::map<std::string, TopicOutput> topics;
+    std::string line;
+    auto start = std::chrono::steady_clock::now();
+    DumpStats stats = DumpDecoder( threads, block ).Decode( dump, size, [&]( const DumpFrame& frame ) {
+        if( ( frame.status != StatusCode::SUCCESS ) || frame.topic.empty() || ( frame.type == PacketType::TOPIC_ANNOUNCE ) )
+        {
+            return;
+        }
+        TopicOutput& topic = topics[ frame.topic ];
+        ++topic.messages;
+        topic.bytes += frame.size;
+        if( !out.empty() )
+        {
+            if( topic.file == nullptr )
+            {
+                topic.file = fopen( ( out + "/" + FileName( frame.topic ) ).c_str(), "w" );
+            }
+            if( topic.file != nullptr )
+            {
+                static const char HEX[] = "0123456789abcdef";
+                line = std::to_string( frame.offset ) + ' ' + static_cast<char>( frame.type ) + ' ';
+                for( size_t i = 0; i < frame.size; ++i )
+                {
+                    line += HEX[ frame.data[ i ] >> 4 ];
+                    line += HEX[ frame.data[ i ] & 0x0F ];
+                }
+                line += '\n';
+                fwrite( line.data(), 1, line.size(), topic.file );
+            }
+        }
+    } );
+    double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+    for( auto& topic : topics )
+    {
+        printf( "%-24s %12llu messages %14llu bytes\n", topic.first.c_str(), static_cast<unsigned long long>( topic.second.messages ),
+                static_cast<unsigned long long>( topic.second.bytes ) );
+        if( topic.second.file != nullptr )
+        {
+            fclose( topic.second.file );
+        }
+    }
+    printf( "%llu frames, %llu decoded, %llu COBS errors, %llu CRC errors, %llu other errors%s\n", static_cast<unsigned long long>( stats.frames ),
+            static_cast<unsigned long long>( stats.decoded ), static_cast<unsigned long long>( stats.cobsErrors ), static_cast<unsigned long long>( stats.crcErrors ),
+            static_cast<unsigned long long>( stats.otherErrors ), stats.incomplete ? ", ends part way through a frame" : "" );
+    printf( "%.1f MB in %.3f s, %.1f MB/s\n", size / 1e6, seconds, seconds > 0 ? size / 1e6 / seconds : 0.0 );
+    if( dump != nullptr )
+    {
+        munmap( const_cast<uint8_t*>( dump ), size );
+    }
+    return 0;
+}
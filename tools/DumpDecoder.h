@@ -0,0 +1,453 @@
+/**
+ * \file    DumpDecoder.h
+ * \author  Julian Mitchell
+ * \date    18 Oct 2026
+ */
+
+#ifndef ESF_TOOLS_DUMP_DECODER_H
+#define ESF_TOOLS_DUMP_DECODER_H
+
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EmbeddedSerialFiller/AckAggregator.h"
+#include "EmbeddedSerialFiller/CobsTranscoder.h"
+#include "EmbeddedSerialFiller/FragmentAssembler.h"
+#include "EmbeddedSerialFiller/TopicDictionary.h"
+#include "EmbeddedSerialFiller/Utilities.h"
+
+// Decodes a raw dump of one direction of a link, on the host, across every core. Uses the heap and threads, so is not
+// for a target.
+
+namespace esf_tools
+{
+/// \brief      One frame of a dump, as given to DumpDecoder's sink, in the order the frames are in the dump.
+struct DumpFrame
+{
+    /// \brief      Where the frame's first byte is in the dump, and its size up to and including the 0x00.
+    uint64_t offset;
+    size_t encodedSize;
+    /// \brief      SUCCESS, or why the frame couldn't be decoded (when the rest is unset).
+    esf::StatusCode status;
+    esf::PacketType type;
+    /// \brief      The packet ID, the topic ID of a TOPIC_ANNOUNCE or TOPIC_ACK, or the sequence number of a STREAM
+    ///             or STREAM_ACK.
+    uint16_t id;
+    /// \brief      The topic of a BROADCAST, PUBLISH, STREAM or FRAGMENT. A topic ID sent in place of the string is
+    ///             resolved from the TOPIC_ANNOUNCEs before it, a StaticTopic is named "#static/<ID>". Empty if
+    ///             neither, with status ERROR_UNKNOWN_TOPIC_ID for an ID never announced.
+    std::string topic;
+    /// \brief      The data, only valid within the sink. For a FRAGMENT, just this fragment's.
+    const uint8_t* data;
+    size_t size;
+};
+
+/// \brief      What a DumpDecoder found.
+struct DumpStats
+{
+    DumpStats() : bytes( 0 ), frames( 0 ), decoded( 0 ), cobsErrors( 0 ), crcErrors( 0 ), otherErrors( 0 ), incomplete( 0 ) {}
+
+    uint64_t bytes;
+    uint64_t frames;
+    uint64_t decoded;
+    uint64_t cobsErrors;
+    uint64_t crcErrors;
+    /// \brief      Malformed, too large, of an unknown type or with an unknown topic ID.
+    uint64_t otherErrors;
+    /// \brief      1 if the dump ends part way through a frame, which is left out.
+    uint64_t incomplete;
+};
+
+/// \brief      Splits a dump at the 0x00 delimiters into blocks of whole frames, COBS decodes and CRC checks the
+///             frames of each block on a pool of threads, then hands them to a sink in dump order.
+/// \details    Once delimited, frames are independent, but for the topic IDs a TopicDictionary sends in place of topic
+///             strings. Those are resolved, from the TOPIC_ANNOUNCEs, as the frames are handed over, on the calling
+///             thread, so the sink needs no lock. No more than a few blocks for each thread are held at once, however
+///             large the dump.
+class DumpDecoder
+{
+   public:
+    typedef std::function<void( const DumpFrame& frame )> Sink;
+
+    /// \param  threads     Threads decoding, 0 for one a core.
+    /// \param  blockSize   Bytes of dump a thread takes at a time, rounded up to a frame boundary.
+    explicit DumpDecoder( unsigned threads = 0, size_t blockSize = 1 << 20 ) : threads_( threads ), blockSize_( blockSize ? blockSize : 1 )
+    {
+        if( threads_ == 0 )
+        {
+            threads_ = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+        }
+    }
+
+    DumpStats Decode( const uint8_t* dump, size_t size, const Sink& sink )
+    {
+        dump_ = dump;
+        size_ = size;
+        blocks_ = ( size + blockSize_ - 1 ) / blockSize_;
+        nextBlock_ = 0;
+        emitted_ = 0;
+        window_ = threads_ * 4;
+        results_.clear();
+        results_.resize( blocks_ );
+        dictionary_.clear();
+
+        std::vector<std::thread> workers;
+        for( unsigned i = 0; i < threads_; ++i )
+        {
+            workers.push_back( std::thread( &DumpDecoder::Work, this ) );
+        }
+
+        DumpStats stats;
+        stats.bytes = size;
+        for( size_t index = 0; index < blocks_; ++index )
+        {
+            std::unique_ptr<Block> block;
+            {
+                std::unique_lock<std::mutex> lock( mutex_ );
+                done_.wait( lock, [&]() { return results_[ index ] != nullptr; } );
+                block = std::move( results_[ index ] );
+                emitted_ = index + 1;
+            }
+            // Let a worker on to the next block.
+            ready_.notify_all();
+            Emit( *block, sink, stats );
+        }
+        for( auto& worker : workers )
+        {
+            worker.join();
+        }
+        return stats;
+    }
+
+   private:
+    /// \brief      Frames CRC checked together, with Utilities::VerifyCrcs().
+    static const size_t BATCH = 8;
+
+    enum class TopicForm : uint8_t
+    {
+        NONE,
+        STRING,
+        ID,
+        STATIC,
+    };
+
+    /// \brief      A frame decoded by a worker, its topic and data within its Block's storage.
+    struct Decoded
+    {
+        uint64_t offset;
+        size_t encodedSize;
+        esf::StatusCode status;
+        esf::PacketType type;
+        uint16_t id;
+        TopicForm topicForm;
+        uint8_t topicId;
+        size_t topic;
+        size_t topicSize;
+        size_t data;
+        size_t size;
+    };
+
+    struct Block
+    {
+        std::vector<Decoded> frames;
+        std::vector<uint8_t> storage;
+        bool incomplete;
+    };
+
+    /// \returns    The start of the first frame at or after \p position: the byte after a 0x00.
+    size_t FrameStart( size_t position ) const
+    {
+        if( position == 0 )
+        {
+            return 0;
+        }
+        if( position >= size_ )
+        {
+            return size_;
+        }
+        const void* end = memchr( dump_ + position - 1, 0x00, size_ - position + 1 );
+        return end ? static_cast<const uint8_t*>( end ) - dump_ + 1 : size_;
+    }
+
+    void Work()
+    {
+        esf::ByteArray encoded;
+        // Frames are COBS decoded into a batch, then CRC checked together.
+        esf::ByteArray decoded[ BATCH ];
+        Decoded batch[ BATCH ];
+        for( ;; )
+        {
+            size_t index;
+            {
+                // Keep within the window, so a slow sink holds back the workers rather than filling memory.
+                std::unique_lock<std::mutex> lock( mutex_ );
+                ready_.wait( lock, [&]() { return ( nextBlock_ >= blocks_ ) || ( nextBlock_ < emitted_ + window_ ); } );
+                if( nextBlock_ >= blocks_ )
+                {
+                    return;
+                }
+                index = nextBlock_++;
+            }
+
+            std::unique_ptr<Block> block( new Block() );
+            block->incomplete = false;
+            size_t batched = 0;
+            size_t end = FrameStart( ( index + 1 ) * blockSize_ );
+            for( size_t start = FrameStart( index * blockSize_ ); start < end; )
+            {
+                const void* delimiter = memchr( dump_ + start, 0x00, end - start );
+                if( delimiter == nullptr )
+                {
+                    block->incomplete = true;
+                    break;
+                }
+                size_t next = static_cast<const uint8_t*>( delimiter ) - dump_ + 1;
+                // Back to back delimiters are not frames.
+                if( next - start > 1 )
+                {
+                    DecodeFrame( start, next - start, encoded, decoded[ batched ], batch[ batched ] );
+                    if( ++batched == BATCH )
+                    {
+                        Finish( decoded, batch, batched, *block );
+                        batched = 0;
+                    }
+                }
+                start = next;
+            }
+            Finish( decoded, batch, batched, *block );
+
+            {
+                std::lock_guard<std::mutex> lock( mutex_ );
+                results_[ index ] = std::move( block );
+            }
+            done_.notify_all();
+        }
+    }
+
+    /// \brief      COBS decodes a frame into \p decoded, leaving the CRC check to Finish().
+    void DecodeFrame( size_t start, size_t encodedSize, esf::ByteArray& encoded, esf::ByteArray& decoded, Decoded& frame ) const
+    {
+        frame.offset = start;
+        frame.encodedSize = encodedSize;
+        frame.type = esf::PacketType::UNKNOWN;
+        frame.id = 0;
+        frame.topicForm = TopicForm::NONE;
+        frame.topicId = 0;
+        frame.topic = frame.topicSize = frame.data = frame.size = 0;
+
+        decoded.clear();
+        if( encodedSize > encoded.max_size() )
+        {
+            // Larger than any node could receive.
+            frame.status = esf::StatusCode::ERROR_RX_DATA_BUFFER_FULL;
+            return;
+        }
+        encoded.assign( dump_ + start, dump_ + start + encodedSize );
+        frame.status = esf::CobsTranscoder::Decode( encoded, decoded );
+    }
+
+    /// \brief      CRC checks a batch of decoded frames together, parses those that pass and adds them all to \p block.
+    static void Finish( const esf::ByteArray* decoded, Decoded* batch, size_t count, Block& block )
+    {
+        const esf::IByteArray* packets[ BATCH ] = {};
+        for( size_t i = 0; i < count; ++i )
+        {
+            packets[ i ] = &decoded[ i ];
+        }
+        uint32_t passed = esf::Utilities::VerifyCrcs( packets, count );
+        for( size_t i = 0; i < count; ++i )
+        {
+            Decoded& frame = batch[ i ];
+            if( ( frame.status == esf::StatusCode::SUCCESS ) && !( passed & ( 1u << i ) ) )
+            {
+                frame.status = ( decoded[ i ].size() < ESF_MIN_BYTES ) ? esf::StatusCode::ERROR_NOT_ENOUGH_BYTES : esf::StatusCode::ERROR_CRC_CHECK_FAILED;
+            }
+            if( frame.status == esf::StatusCode::SUCCESS )
+            {
+                frame.status = Parse( decoded[ i ], frame );
+            }
+            if( frame.status == esf::StatusCode::SUCCESS )
+            {
+                // Keep the topic and data, the rest of the packet isn't needed.
+                size_t base = block.storage.size();
+                size_t first = frame.topicSize ? frame.topic : frame.data;
+                block.storage.insert( block.storage.end(), decoded[ i ].begin() + first, decoded[ i ].begin() + frame.data + frame.size );
+                frame.topic = base + ( frame.topic - first );
+                frame.data = base + ( frame.data - first );
+            }
+            block.frames.push_back( frame );
+        }
+    }
+
+    /// \brief      Finds the topic and data of a decoded, CRC checked packet, as GiveRxData() would.
+    static esf::StatusCode Parse( const esf::IByteArray& packet, Decoded& frame )
+    {
+        frame.type = static_cast<esf::PacketType>( packet[ 0 ] );
+        frame.id = packet[ 1 ];
+        size_t end = packet.size() - 2;
+        size_t startAt = 2;
+        switch( frame.type )
+        {
+            case esf::PacketType::BROADCAST_ACKS:
+            case esf::PacketType::PUBLISH_ACKS:
+                startAt += esf::AckAggregator::BLOCK_SIZE;
+                // Fall through.
+            case esf::PacketType::BROADCAST:
+            case esf::PacketType::PUBLISH:
+                if( startAt >= end )
+                {
+                    return esf::StatusCode::ERROR_NOT_ENOUGH_BYTES;
+                }
+                if( ( packet[ startAt ] & ESF_STATIC_TOPIC_FLAG ) == ESF_STATIC_TOPIC_FLAG )
+                {
+                    frame.topicForm = TopicForm::STATIC;
+                    frame.topicId = packet[ startAt ] & ~ESF_STATIC_TOPIC_FLAG;
+                    return Data( startAt + 1, end, frame );
+                }
+                if( packet[ startAt ] & esf::TopicDictionary::TOPIC_ID_FLAG )
+                {
+                    frame.topicForm = TopicForm::ID;
+                    frame.topicId = packet[ startAt ] & ~esf::TopicDictionary::TOPIC_ID_FLAG;
+                    return Data( startAt + 1, end, frame );
+                }
+                return TopicString( packet, startAt, end, frame );
+            case esf::PacketType::STREAM:
+            case esf::PacketType::STREAM_ACK:
+                if( end < 3 )
+                {
+                    return esf::StatusCode::ERROR_NOT_ENOUGH_BYTES;
+                }
+                frame.id = static_cast<uint16_t>( ( packet[ 1 ] << 8 ) | packet[ 2 ] );
+                return ( frame.type == esf::PacketType::STREAM ) ? TopicString( packet, 3, end, frame ) : esf::StatusCode::SUCCESS;
+            case esf::PacketType::FRAGMENT:
+                if( end < esf::FragmentAssembler::HEADER_SIZE )
+                {
+                    return esf::StatusCode::ERROR_NOT_ENOUGH_BYTES;
+                }
+                return TopicString( packet, esf::FragmentAssembler::HEADER_SIZE - 1, end, frame );
+            case esf::PacketType::TOPIC_ANNOUNCE:
+                return TopicString( packet, 2, end, frame );
+            case esf::PacketType::ACK:
+            case esf::PacketType::ACK_BITMAP:
+            case esf::PacketType::TOPIC_ACK:
+                return esf::StatusCode::SUCCESS;
+            default:
+                return esf::StatusCode::ERROR_UNRECOGNISED_PACKET_TYPE;
+        }
+    }
+
+    /// \brief      As Utilities::SplitPacket(), without the copies.
+    static esf::StatusCode TopicString( const esf::IByteArray& packet, size_t startAt, size_t end, Decoded& frame )
+    {
+        if( ( startAt >= end ) || ( packet[ startAt ] > end - startAt - 1 ) )
+        {
+            return esf::StatusCode::ERROR_LENGTH_OF_TOPIC_TOO_LONG;
+        }
+        frame.topicForm = TopicForm::STRING;
+        frame.topic = startAt + 1;
+        frame.topicSize = packet[ startAt ];
+        return Data( frame.topic + frame.topicSize, end, frame );
+    }
+
+    static esf::StatusCode Data( size_t start, size_t end, Decoded& frame )
+    {
+        frame.data = start;
+        frame.size = end - start;
+        return esf::StatusCode::SUCCESS;
+    }
+
+    void Emit( const Block& block, const Sink& sink, DumpStats& stats )
+    {
+        DumpFrame frame;
+        for( const auto& decoded : block.frames )
+        {
+            ++stats.frames;
+            frame.offset = decoded.offset;
+            frame.encodedSize = decoded.encodedSize;
+            frame.status = decoded.status;
+            frame.type = decoded.type;
+            frame.id = decoded.id;
+            frame.topic.clear();
+            frame.data = nullptr;
+            frame.size = 0;
+            if( decoded.status == esf::StatusCode::SUCCESS )
+            {
+                frame.data = block.storage.data() + decoded.data;
+                frame.size = decoded.size;
+                if( decoded.topicForm == TopicForm::STRING )
+                {
+                    frame.topic.assign( reinterpret_cast<const char*>( block.storage.data() + decoded.topic ), decoded.topicSize );
+                    if( decoded.type == esf::PacketType::TOPIC_ANNOUNCE )
+                    {
+                        dictionary_[ static_cast<uint8_t>( decoded.id ) ] = frame.topic;
+                    }
+                }
+                else if( decoded.topicForm == TopicForm::ID )
+                {
+                    auto known = dictionary_.find( decoded.topicId );
+                    if( known == dictionary_.end() )
+                    {
+                        frame.status = esf::StatusCode::ERROR_UNKNOWN_TOPIC_ID;
+                    }
+                    else
+                    {
+                        frame.topic = known->second;
+                    }
+                }
+                else if( decoded.topicForm == TopicForm::STATIC )
+                {
+                    frame.topic = "#static/" + std::to_string( decoded.topicId );
+                }
+            }
+            Count( frame.status, stats );
+            sink( frame );
+        }
+        stats.incomplete += block.incomplete ? 1 : 0;
+    }
+
+    static void Count( esf::StatusCode status, DumpStats& stats )
+    {
+        if( status == esf::StatusCode::SUCCESS )
+        {
+            ++stats.decoded;
+        }
+        else if( status == esf::StatusCode::ERROR_CRC_CHECK_FAILED )
+        {
+            ++stats.crcErrors;
+        }
+        else if( status == esf::StatusCode::ERROR_ZERO_BYTE_NOT_EXPECTED )
+        {
+            ++stats.cobsErrors;
+        }
+        else
+        {
+            ++stats.otherErrors;
+        }
+    }
+
+    unsigned threads_;
+    size_t blockSize_;
+    const uint8_t* dump_;
+    size_t size_;
+    size_t blocks_;
+    size_t window_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::condition_variable done_;
+    size_t nextBlock_;
+    size_t emitted_;
+    std::vector<std::unique_ptr<Block> > results_;
+    // Topic IDs announced so far, in dump order.
+    std::map<uint8_t, std::string> dictionary_;
+};
+
+}  // namespace esf_tools
+
+#endif  // #ifndef ESF_TOOLS_DUMP_DECODER_H